@@ -0,0 +1,86 @@
+// arena.h
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <google/protobuf/arena.h>
+#include <grpcpp/support/message_allocator.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Allocation counts for the protobuf arenas of a job or a server. Arenas
+// report here when they are reset or destroyed.
+struct ArenaStats {
+    std::atomic<uint64_t> arenas{0};         // Arena lifetimes (calls, frames)
+    std::atomic<uint64_t> messages{0};       // Top-level messages created on them
+    std::atomic<uint64_t> bytesUsed{0};      // Arena space the messages took
+    std::atomic<uint64_t> heapBytes{0};      // Blocks allocated past the inline ones
+
+    void reset();
+
+    // One line of averages over count units of work (chunks, RPCs)
+    std::string summary(uint64_t count) const;
+};
+
+// Protobuf arena whose first block is part of the object, so the messages of
+// a typical call are carved out of it with no heap allocation. Payload-sized
+// strings still overflow into heap blocks, which the stats show.
+class CallArena {
+public:
+    static constexpr size_t kInlineBlockSize = 2048;
+
+    explicit CallArena(ArenaStats* stats = nullptr);
+    ~CallArena();
+
+    CallArena(const CallArena&) = delete;
+    CallArena& operator=(const CallArena&) = delete;
+
+    template <typename Message>
+    Message* create() {
+        ++messages_;
+        return google::protobuf::Arena::CreateMessage<Message>(&arena_);
+    }
+
+    // Frees every message created so far for reuse of the arena
+    void reset();
+
+private:
+    void record();
+
+    ArenaStats* stats_;
+    size_t messages_ = 0;
+    alignas(std::max_align_t) char block_[kInlineBlockSize];
+    google::protobuf::Arena arena_;
+};
+
+// gRPC MessageAllocator for callback services: each RPC's request and response
+// live on their own CallArena, released with the RPC. Register it with the
+// generated SetMessageAllocatorFor_<Method>; it must outlive the server.
+template <typename Request, typename Response>
+class ArenaMessageAllocator : public grpc::MessageAllocator<Request, Response> {
+public:
+    explicit ArenaMessageAllocator(ArenaStats* stats = nullptr) : stats_(stats) {}
+
+    grpc::MessageHolder<Request, Response>* AllocateMessages() override {
+        return new Holder(stats_);
+    }
+
+private:
+    class Holder : public grpc::MessageHolder<Request, Response> {
+    public:
+        explicit Holder(ArenaStats* stats) : arena_(stats) {
+            this->set_request(arena_.create<Request>());
+            this->set_response(arena_.create<Response>());
+        }
+
+        void Release() override { delete this; }
+
+    private:
+        CallArena arena_;
+    };
+
+    ArenaStats* stats_;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,89 @@
+// channel_registry.h
+#ifndef CHANNEL_REGISTRY_H
+#define CHANNEL_REGISTRY_H
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "encryption.grpc.pb.h"
+
+// One connection to a worker, with the stub that uses it and the number of
+// requests currently running on it across the whole process
+struct WorkerChannel {
+    std::shared_ptr<grpc::Channel> channel;
+    std::unique_ptr<encryption::EncryptionService::Stub> stub;
+    std::unique_ptr<grpc::GenericStub> generic;  // Same connection, for ChunkWire calls
+    std::atomic<size_t> outstanding{0};
+};
+
+// The connections to one worker. Every request leases the connection with the
+// fewest requests outstanding and gives it back when it completes.
+class ChannelPool {
+public:
+    // Holds one request's share of a connection; released on destruction
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        encryption::EncryptionService::Stub* operator->() const { return channel_->stub.get(); }
+        encryption::EncryptionService::Stub& stub() const { return *channel_->stub; }
+        grpc::GenericStub& generic() const { return *channel_->generic; }
+        size_t index() const { return index_; }
+        void release();
+
+    private:
+        friend class ChannelPool;
+        Lease(std::shared_ptr<WorkerChannel> channel, size_t index);
+
+        std::shared_ptr<WorkerChannel> channel_;
+        size_t index_ = 0;
+    };
+
+    ChannelPool(std::string address, std::vector<std::shared_ptr<WorkerChannel>> channels);
+
+    const std::string& address() const { return address_; }
+    size_t size() const { return channels_.size(); }
+
+    Lease lease();
+
+private:
+    std::string address_;
+    std::vector<std::shared_ptr<WorkerChannel>> channels_;
+};
+
+// Process-wide cache of worker connections, so every master, dispatcher and
+// probe in the process shares them instead of dialing again. A worker can get
+// several connections: each one is created with distinct channel arguments
+// and its own subchannel pool, so gRPC opens a separate HTTP/2 connection for
+// each and one connection's flow-control window no longer caps throughput on
+// high bandwidth-delay links.
+class ChannelRegistry {
+public:
+    static ChannelRegistry& instance();
+
+    // The first `connections` connections to the worker, creating missing ones
+    std::shared_ptr<ChannelPool> pool(const std::string& address, bool useTLS, size_t connections = 1);
+
+private:
+    ChannelRegistry() = default;
+    std::shared_ptr<grpc::Channel> createChannel(const std::string& address, bool useTLS, size_t index);
+
+    using Key = std::tuple<std::string, bool, size_t>;  // address, TLS, connection index
+
+    std::mutex mutex_;
+    std::map<Key, std::shared_ptr<WorkerChannel>> channels_;
+};
+
+#endif // CHANNEL_REGISTRY_H
@@ -3,16 +3,71 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
+#include <cstdint>
+#include <memory>
 
 struct FileChunk {
     std::vector<char> data;
     int id;
+    uint64_t offset = 0;  // Byte offset of this chunk in the source file
+
+    // Shared-storage mode describes the chunk instead of carrying it: data
+    // stays empty and the worker reads length bytes at offset itself, then
+    // writes its result at outputOffset of the output file
+    size_t length = 0;
+    uint64_t outputOffset = 0;
+
+    // Once sent without copying (see ChunkWire), the bytes live here, shared
+    // with gRPC, and data is empty. Copies of the chunk share them too.
+    std::shared_ptr<const std::vector<char>> shared;
+
+    // Moves data into shared, once, and returns it
+    const std::shared_ptr<const std::vector<char>>& share() {
+        if (!shared) {
+            shared = std::make_shared<const std::vector<char>>(std::move(data));
+            data.clear();
+        }
+        return shared;
+    }
+
+    const char* bytes() const { return shared ? shared->data() : data.data(); }
+
+    // Input bytes the chunk stands for
+    size_t byteCount() const { return shared ? shared->size() : data.empty() ? length : data.size(); }
+};
+
+// Pull-based chunk source: reads one fixed-size chunk per call so a file can be
+// processed without ever holding more than the chunks currently in flight
+class ChunkReader {
+public:
+    ChunkReader(const std::string& filePath, size_t chunkSize);
+
+    // Reads the next chunk; returns false once the end of the file is reached
+    bool next(FileChunk& chunk);
+
+    // Reads an explicit byte range as the next chunk (for indexed layouts)
+    bool readRange(uint64_t offset, size_t size, FileChunk& chunk);
+
+    uint64_t fileSize() const { return fileSize_; }
+    size_t chunkSize() const { return chunkSize_; }
+    size_t chunkCount() const;
+
+private:
+    std::ifstream file_;
+    size_t chunkSize_;
+    uint64_t fileSize_ = 0;
+    uint64_t offset_ = 0;
+    int nextId_ = 0;
 };
 
 class FileChunker {
 public:
     static std::vector<FileChunk> chunkFile(const std::string& filePath, size_t chunkSize);
     static bool reassembleFile(const std::string& outputPath, const std::vector<FileChunk>& chunks);
+
+    // Chunk size actually used for a requested size (avoids exact AES block multiples)
+    static size_t effectiveChunkSize(size_t chunkSize);
 };
 
 #endif // CHUNK_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+// container.h
+#ifndef CONTAINER_H
+#define CONTAINER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "crypto.h"
+
+// Encrypted file layout (all integers little-endian):
+//
+//   header  (80 bytes)  magic, version, cipher, chunk size, chunk count,
+//                       original length, index and data offsets and up to
+//                       16 bytes of cipher parameters
+//   index   (16 bytes per chunk)  ciphertext offset, ciphertext length,
+//                                 plaintext length
+//   data    concatenated chunk ciphertexts
+//   footer  (16 bytes)  magic and chunk count, written last
+//
+// Every chunk boundary is known from the index alone, so decryption can plan
+// and dispatch all chunks up front. From version 2, GCM chunks authenticate
+// the header as associated data, so a file truncated and given a consistent
+// header, index and footer fails to decrypt instead of coming out shorter.
+
+struct ContainerHeader {
+    uint16_t version = 0;
+    CipherMode cipher = CipherMode::AES_256_CBC;
+    uint32_t chunkSize = 0;
+    uint64_t chunkCount = 0;
+    uint64_t originalLength = 0;
+    uint64_t indexOffset = 0;
+    uint64_t dataOffset = 0;
+    std::string cipherParams;  // Up to 16 bytes of cipher-specific parameters
+};
+
+struct ContainerIndexEntry {
+    uint64_t cipherOffset = 0;
+    uint32_t cipherLength = 0;
+    uint32_t plainLength = 0;
+};
+
+class ContainerLayout {
+public:
+    static constexpr uint16_t kVersion = 2;
+    static constexpr size_t kHeaderSize = 80;
+    static constexpr size_t kIndexEntrySize = 16;
+    static constexpr size_t kFooterSize = 16;
+    static constexpr size_t kMaxCipherParams = 16;
+
+    // Plans the layout for encrypting a file of the given length
+    static ContainerLayout plan(CipherMode cipher, uint32_t chunkSize, uint64_t originalLength);
+
+    // Reads and validates the header, index and footer of an encrypted file
+    static ContainerLayout read(const std::string& path);
+
+    // True if the file starts with the container magic
+    static bool isContainer(const std::string& path);
+
+    // Layout of an unframed file written before the container format existed:
+    // back-to-back CBC chunks of encryptedSize(plainChunkSize) bytes. Version
+    // is 0 and the original length is unknown.
+    static ContainerLayout legacy(uint64_t fileSize, uint32_t plainChunkSize);
+
+    bool isFramed() const { return header_.version != 0; }
+
+    const ContainerHeader& header() const { return header_; }
+    ContainerHeader& header() { return header_; }
+    const std::vector<ContainerIndexEntry>& entries() const { return entries_; }
+
+    // Offset of chunk i in the decrypted output
+    uint64_t plainOffset(size_t index) const { return static_cast<uint64_t>(index) * header_.chunkSize; }
+    uint64_t footerOffset() const;
+    uint64_t totalSize() const { return footerOffset() + kFooterSize; }
+
+    // IV to hand the cipher for every chunk: iv itself for CBC; for GCM the
+    // file nonce followed, from version 2, by the serialized header
+    std::string chunkIV(const std::string& iv) const;
+
+    std::vector<char> serializeHeader() const;
+    std::vector<char> serializeHeaderAndIndex() const;
+    std::vector<char> serializeFooter() const;
+
+private:
+    ContainerHeader header_;
+    std::vector<ContainerIndexEntry> entries_;
+};
+
+#endif // CONTAINER_H
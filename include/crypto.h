@@ -4,21 +4,160 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+
+struct evp_cipher_ctx_st;
+
+// Cipher identifiers; the numeric values are stored in the container header
+// and match encryption::Cipher on the wire
+enum class CipherMode : uint16_t {
+    AES_256_CBC = 1,  // Shared key + IV, PKCS#7 padding per chunk
+    AES_256_GCM = 2   // Per-chunk nonce derived from a file nonce, 16-byte tag per chunk
+};
+
+// Non-owning views over caller-provided bytes. They convert implicitly from
+// vectors and strings so protobuf bytes fields can be passed without copying.
+struct ConstByteSpan {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+    ConstByteSpan() = default;
+    ConstByteSpan(const void* bytes, size_t length)
+        : data(static_cast<const unsigned char*>(bytes)), size(length) {}
+    ConstByteSpan(const std::string& bytes) : ConstByteSpan(bytes.data(), bytes.size()) {}
+    template <typename T>
+    ConstByteSpan(const std::vector<T>& bytes) : ConstByteSpan(bytes.data(), bytes.size() * sizeof(T)) {}
+};
+
+struct MutableByteSpan {
+    unsigned char* data = nullptr;
+    size_t size = 0;
+
+    MutableByteSpan() = default;
+    MutableByteSpan(void* bytes, size_t length)
+        : data(static_cast<unsigned char*>(bytes)), size(length) {}
+    MutableByteSpan(std::string& bytes) : MutableByteSpan(&bytes[0], bytes.size()) {}
+    template <typename T>
+    MutableByteSpan(std::vector<T>& bytes) : MutableByteSpan(bytes.data(), bytes.size() * sizeof(T)) {}
+};
+
+enum class CipherDirection {
+    Encrypt,
+    Decrypt
+};
+
+// An OpenSSL cipher context that has already been keyed. Processing another
+// chunk only resets the IV/nonce and runs update/final, so the context
+// allocation, cipher fetch and key schedule are paid once per key rather than
+// once per chunk. Obtain one through AESCrypto::context().
+class CipherContext {
+public:
+    CipherContext(CipherMode mode, CipherDirection direction, const std::string& key);
+    ~CipherContext();
+
+    CipherContext(const CipherContext&) = delete;
+    CipherContext& operator=(const CipherContext&) = delete;
+
+    // For CBC the iv is used as is and chunkIndex is ignored; for GCM the iv
+    // is the 12-byte file nonce, optionally followed by associated data that
+    // every chunk authenticates, and the chunk nonce is derived from chunkIndex
+    std::vector<unsigned char> encrypt(const std::vector<char>& data,
+                                       const std::string& iv,
+                                       uint64_t chunkIndex);
+
+    std::vector<char> decrypt(const std::vector<unsigned char>& encryptedData,
+                              const std::string& iv,
+                              uint64_t chunkIndex);
+
+    // Span variants write into caller-provided memory and return the number of
+    // bytes produced. output must hold at least AESCrypto::encryptedSize(input)
+    // bytes for encryption and AESCrypto::maxDecryptedSize(input) for
+    // decryption. Both modes work in place (output.data == input.data); other
+    // overlaps are rejected.
+    size_t encrypt(ConstByteSpan input, MutableByteSpan output,
+                   const std::string& iv, uint64_t chunkIndex);
+
+    size_t decrypt(ConstByteSpan input, MutableByteSpan output,
+                   const std::string& iv, uint64_t chunkIndex);
+
+    CipherMode mode() const { return mode_; }
+    CipherDirection direction() const { return direction_; }
+    bool matches(CipherMode mode, CipherDirection direction, const std::string& key) const;
+
+private:
+    void resetIV(const std::string& iv, uint64_t chunkIndex);
+
+    CipherMode mode_;
+    CipherDirection direction_;
+    std::string key_;
+    evp_cipher_ctx_st* ctx_;
+};
 
 class AESCrypto {
 public:
     static std::vector<unsigned char> encrypt(const std::vector<char>& data,
                                             const std::string& key,
                                             const std::string& iv);
-    
+
     static std::vector<char> decrypt(const std::vector<unsigned char>& encryptedData,
                                    const std::string& key,
                                    const std::string& iv);
-    
+
+    // Mode-aware variants. For CBC the iv is used as is and chunkIndex is
+    // ignored; for GCM the iv is the 12-byte file nonce (plus any associated
+    // data), each chunk gets its own nonce from chunkNonce() and the tag is
+    // appended to the ciphertext.
+    static std::vector<unsigned char> encrypt(CipherMode mode,
+                                            const std::vector<char>& data,
+                                            const std::string& key,
+                                            const std::string& iv,
+                                            uint64_t chunkIndex);
+
+    static std::vector<char> decrypt(CipherMode mode,
+                                   const std::vector<unsigned char>& encryptedData,
+                                   const std::string& key,
+                                   const std::string& iv,
+                                   uint64_t chunkIndex);
+
+    // Span variants; see CipherContext for the output size and aliasing rules
+    static size_t encrypt(CipherMode mode, ConstByteSpan input, MutableByteSpan output,
+                          const std::string& key, const std::string& iv, uint64_t chunkIndex);
+
+    static size_t decrypt(CipherMode mode, ConstByteSpan input, MutableByteSpan output,
+                          const std::string& key, const std::string& iv, uint64_t chunkIndex);
+
+    // Keyed context from the calling thread's cache (a few most recently used
+    // keys are kept). The reference stays valid until this thread requests
+    // enough other keys to evict it, so use it right away rather than storing it.
+    static CipherContext& context(CipherMode mode, CipherDirection direction, const std::string& key);
+
+    // Ciphertext length for a plaintext of the given size
+    // (CBC: PKCS#7 padding to the next block, GCM: plaintext plus tag)
+    static size_t encryptedSize(size_t plaintextSize, CipherMode mode = CipherMode::AES_256_CBC);
+
+    // Upper bound on the plaintext length of a ciphertext of the given size
+    static size_t maxDecryptedSize(size_t encryptedSize, CipherMode mode = CipherMode::AES_256_CBC);
+
+    // GCM nonce for one chunk: the file nonce (the first 12 bytes of fileNonce)
+    // with the chunk index XORed into its last 8 bytes
+    static std::string chunkNonce(const std::string& fileNonce, uint64_t chunkIndex);
+
     static void generateKeyIV(std::string& key, std::string& iv);
-    
+
+    // Random 12-byte file nonce for GCM
+    static std::string generateNonce();
+
+    static CipherMode parseCipherMode(const std::string& name);
+    static std::string cipherModeName(CipherMode mode);
+
+    // Ciphers the linked OpenSSL provides
+    static std::vector<CipherMode> availableModes();
+
+    // True if the CPU has AES instructions (AES-NI), which OpenSSL uses when present
+    static bool hardwareAes();
+
     // Add this new method
     static void printHex(const std::string& data, const std::string& label);
 };
 
-#endif // CRYPTO_H
\ No newline at end of file
+#endif // CRYPTO_H
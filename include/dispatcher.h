@@ -0,0 +1,423 @@
+// dispatcher.h
+#ifndef DISPATCHER_H
+#define DISPATCHER_H
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "encryption.pb.h"
+#include "encryption.grpc.pb.h"
+#include "arena.h"
+#include "channel_registry.h"
+#include "chunk.h"
+#include "crypto.h"
+#include "fair_share.h"
+#include "local_pool.h"
+#include "membership.h"
+#include "memory_budget.h"
+#include "scheduler.h"
+#include "shared_ring.h"
+
+enum class ChunkOperation {
+    Encrypt,
+    Decrypt
+};
+
+// Pipelined chunk dispatch over the generated async stubs. Every worker keeps
+// up to maxInFlightPerWorker requests outstanding, and each freed slot pulls
+// the next chunk for the worker the WorkerScheduler expects to finish it
+// soonest, so faster workers take more of the file. Completions are drained
+// from a single CompletionQueue and handed back by input index, so results can
+// be slotted into place regardless of the order workers finish in.
+//
+// Chunks are pulled from the source only when a worker slot frees up, so the
+// dispatcher never holds more than the in-flight window in memory.
+//
+// Every request runs on the least busy of the worker's connections (see
+// ChannelPool). By default each connection gets one ProcessChunks stream and
+// chunk frames are pushed down it back to back; workers that do not implement
+// the stream fall back to one unary call per chunk. Streams and unary calls
+// go through ChunkWire, so requests reference chunk bytes rather than copy
+// them; batches use the generated stubs. Request and response messages live
+// on per-call protobuf arenas (see CallArena), and the dispatch summary
+// reports how much they allocated per chunk.
+//
+// A failed chunk is retried with exponential backoff on a different worker
+// before the failure handler sees it. Workers taken out of rotation by the
+// scheduler's circuit breaker are probed with TestConnection and return to
+// rotation once they answer, so a job carries on with the healthy workers.
+//
+// With a LocalCryptoPool attached, the master itself is one more worker with a
+// slot per pool thread, scheduled like the remote ones. It takes the first
+// null entry of the worker list, or an index past the end if there is none.
+//
+// Given a WorkerMembership, the worker list follows it during the job:
+// workers that register are sent chunks right away, draining workers finish
+// what they have but get nothing new, and chunks outstanding on a dropped
+// worker are resent elsewhere.
+class ChunkDispatcher {
+public:
+    using ChunkSource = std::function<bool(FileChunk& chunk)>;
+    using CompletionHandler = std::function<void(size_t index, FileChunk&& result)>;
+    using FailureHandler = std::function<void(size_t index, const FileChunk& input, const std::string& error)>;
+
+    ChunkDispatcher(const std::vector<std::shared_ptr<ChannelPool>>& workers,
+                    size_t maxInFlightPerWorker);
+
+    // Pulls chunks from the source until it is exhausted and blocks until all
+    // of them have completed or failed. Exceptions thrown by the source or the
+    // handlers cancel the remaining calls and propagate.
+    void dispatch(const ChunkSource& source,
+                  ChunkOperation operation,
+                  const std::string& key,
+                  const std::string& iv,
+                  const CompletionHandler& onComplete,
+                  const FailureHandler& onFailure);
+
+    // Convenience overload for chunks that are already in memory
+    void dispatch(const std::vector<FileChunk>& chunks,
+                  ChunkOperation operation,
+                  const std::string& key,
+                  const std::string& iv,
+                  const CompletionHandler& onComplete,
+                  const FailureHandler& onFailure);
+
+    void setCallTimeout(std::chrono::seconds timeout) { callTimeout_ = timeout; }
+
+    // Shares a scheduler (and the stats it has gathered) across dispatches.
+    // Without one, each dispatcher measures its workers from scratch.
+    void setScheduler(WorkerScheduler* scheduler) { scheduler_ = scheduler; }
+
+    // Cipher requested from the workers (AES-256-CBC unless set)
+    void setCipherMode(CipherMode mode) { cipherMode_ = mode; }
+
+    // Register the key and IV once per worker with OpenSession at the start of
+    // each dispatch, so chunk requests carry only a session id (on by default).
+    // Workers that do not support sessions get the key inline as before.
+    void setUseSessions(bool useSessions) { useSessions_ = useSessions; }
+
+    // Send chunks over a ProcessChunks stream per worker (on by default)
+    // instead of one unary call per chunk
+    void setUseStreaming(bool useStreaming) { useStreaming_ = useStreaming; }
+
+    // Pack up to maxChunks chunks (and at most maxBytes of payload, though a
+    // single larger chunk still goes alone) into each EncryptBatch/DecryptBatch
+    // call. Meant for small chunks, where per-call overhead dominates; when
+    // maxChunks > 1 batches replace the per-worker streams.
+    void setBatchLimits(size_t maxChunks, size_t maxBytes) {
+        maxBatchChunks_ = std::max<size_t>(1, maxChunks);
+        maxBatchBytes_ = maxBytes;
+    }
+
+    // Process chunks in-process on the pool as well as on the remote workers.
+    // With localOnly the remote workers are not used at all.
+    void setLocalPool(LocalCryptoPool* pool, bool localOnly = false) {
+        localPool_ = pool;
+        localOnly_ = pool && localOnly;
+    }
+
+    // Bound the chunk data this dispatch holds (and, through a shared budget,
+    // all jobs together). Each chunk read from the source reserves
+    // kCopiesPerChunk times chunkSize until it settles: its input, the request,
+    // the response and the result written out. Reading stalls while the
+    // budget is spent.
+    void setMemoryBudget(MemoryBudget* budget, size_t chunkSize) {
+        memoryBudget_ = budget;
+        budgetPerChunk_ = kCopiesPerChunk * (static_cast<uint64_t>(chunkSize) + kCipherOverhead);
+    }
+
+    // Retry a failed chunk up to maxRetries times on another worker, waiting
+    // backoff before the first retry and doubling it for each one after
+    void setRetryPolicy(size_t maxRetries, std::chrono::milliseconds backoff) {
+        maxRetries_ = maxRetries;
+        retryBackoff_ = backoff;
+    }
+
+    // Hedge stragglers: once enough chunks have completed, a chunk outstanding
+    // for longer than this percentile of observed chunk latency (e.g. 95) is
+    // sent again to an idle worker. The first result wins and the other
+    // attempt is cancelled (0 = off).
+    void setHedgePercentile(double percentile) { hedgePercentile_ = percentile; }
+
+    // Run as one of several jobs sharing the workers: every window, the local
+    // pool's included, is scaled by the job's current share
+    void setFairShare(FairShare* shares, size_t jobId) {
+        fairShare_ = shares;
+        fairShareId_ = jobId;
+    }
+
+    // Shared-storage mode: chunks from the source are range descriptors of
+    // inputPath (see FileChunk) and every worker reads and writes the files
+    // itself with ProcessRange, so no chunk data passes through the master.
+    // Both paths must be the same on every host. Chunks go as unary calls,
+    // and the local pool is not used; results carry only their length.
+    void setSharedStorage(const std::string& inputPath, const std::string& outputPath) {
+        sharedInput_ = inputPath;
+        sharedOutput_ = outputPath;
+    }
+
+    // Workers on the master's host (sameHost[i]) are sent chunks through a
+    // SharedRing of chunkSize slots attached at the start of each dispatch:
+    // the request carries a slot offset and the worker processes the chunk in
+    // place. These workers get unary calls, not streams. Chunks that do not
+    // fit or find no free slot, and workers that cannot map the ring, use the
+    // request as usual.
+    void setSameHostWorkers(const std::vector<bool>& sameHost, size_t chunkSize) {
+        sameHost_ = sameHost;
+        ringSlotSize_ = chunkSize + kCipherOverhead;
+    }
+
+    // Follow the master's worker membership while dispatching
+    void setMembership(WorkerMembership* membership) { membership_ = membership; }
+
+    // Polled while dispatching; once it is set the outstanding calls are
+    // cancelled and dispatch throws
+    void setCancelFlag(const std::atomic<bool>* cancelled) { cancelled_ = cancelled; }
+
+private:
+    static constexpr size_t kMinHedgeSamples = 16;    // Latencies needed before hedging starts
+    static constexpr size_t kMaxLatencySamples = 512;
+    static constexpr std::chrono::milliseconds kHedgePollInterval{20};
+    static constexpr std::chrono::milliseconds kMaxRetryBackoff{5000};
+    static constexpr std::chrono::milliseconds kProbeDelay{1000};      // First re-admission probe
+    static constexpr std::chrono::milliseconds kMaxProbeDelay{30000};
+    static constexpr std::chrono::seconds kMaxOutage{60};              // With no worker in rotation
+    static constexpr std::chrono::milliseconds kBudgetPollInterval{10};
+    static constexpr std::chrono::milliseconds kCancelPollInterval{100};
+    static constexpr std::chrono::milliseconds kMembershipPollInterval{500};
+    static constexpr std::chrono::seconds kControlTimeout{5};          // Session and ring setup or teardown
+    static constexpr uint64_t kCopiesPerChunk = 4;
+    static constexpr uint64_t kCipherOverhead = 32;  // Padding or tag, rounded up
+
+    // Unary calls and stream operations complete on the same queue; every tag
+    // starts with its kind
+    struct Tag {
+        enum class Kind { Call, Batch, Probe, Local, StreamStart, StreamRead, StreamWrite, StreamWritesDone, StreamFinish };
+        explicit Tag(Kind kind) : kind(kind) {}
+        Kind kind;
+    };
+
+    struct PendingCall : Tag {
+        explicit PendingCall(ArenaStats* stats)
+            : Tag(Kind::Call), arena(stats), response(arena.create<encryption::ChunkResponse>()) {}
+        size_t index = 0;
+        size_t workerIndex = 0;
+        FileChunk input;
+        WorkerScheduler::Clock::time_point sentAt;
+        bool hedge = false;
+        ChannelPool::Lease channel;  // Connection the request runs on
+        grpc::ClientContext context;
+        CallArena arena;                     // Holds the request fields and the response
+        grpc::ByteBuffer reply;
+        encryption::ChunkResponse* response;  // Decoded from reply, except for the result
+        std::vector<char> output;            // The result
+        grpc::Status status;
+        std::unique_ptr<grpc::GenericClientAsyncResponseReader> reader;
+        SharedRing* ring = nullptr;          // Set if the chunk went through the worker's ring
+        size_t ringSlot = SharedRing::kNoSlot;
+    };
+
+    using BatchItems = std::vector<std::pair<size_t, FileChunk>>;  // (index, input)
+
+    struct PendingBatch : Tag {
+        explicit PendingBatch(ArenaStats* stats)
+            : Tag(Kind::Batch), arena(stats), response(arena.create<encryption::BatchResponse>()) {}
+        size_t workerIndex = 0;
+        BatchItems items;
+        WorkerScheduler::Clock::time_point sentAt;
+        ChannelPool::Lease channel;  // Connection the request runs on
+        grpc::ClientContext context;
+        CallArena arena;                     // Holds the request and the response
+        encryption::BatchResponse* response;
+        grpc::Status status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<encryption::BatchResponse>> reader;
+    };
+
+    // TestConnection sent to a worker that is out of rotation
+    struct PendingProbe : Tag {
+        PendingProbe() : Tag(Kind::Probe) {}
+        size_t workerIndex = 0;
+        ChannelPool::Lease channel;  // Connection the request runs on
+        grpc::ClientContext context;
+        encryption::TestResponse response;
+        grpc::Status status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<encryption::TestResponse>> reader;
+    };
+
+    // Chunk processed on the local pool; the alarm posts it to the completion
+    // queue when the pool thread is done, so it completes like a remote call
+    struct PendingLocal : Tag {
+        PendingLocal() : Tag(Kind::Local) {}
+        size_t index = 0;
+        size_t workerIndex = 0;
+        FileChunk input;
+        WorkerScheduler::Clock::time_point sentAt;
+        encryption::ChunkResponse response;
+        grpc::Alarm alarm;
+    };
+
+    // A failed chunk waiting for its backoff to expire
+    struct RetryItem {
+        size_t index;
+        FileChunk input;
+        size_t failedWorker;
+    };
+
+    // Outstanding attempts for one chunk; more than one once it is hedged
+    struct ChunkState {
+        size_t attempts = 0;
+        size_t reservations = 1;             // Budget shares held, one more with a hedge
+        size_t retries = 0;
+        size_t workerIndex = 0;              // Worker of the first attempt
+        WorkerScheduler::Clock::time_point sentAt;
+        const FileChunk* input = nullptr;    // First attempt's input, for hedging
+        bool hedged = false;
+        std::vector<PendingCall*> calls;     // Unary attempts, which can be cancelled one by one
+    };
+
+    struct StreamedChunk {
+        FileChunk input;
+        WorkerScheduler::Clock::time_point sentAt;
+    };
+
+    struct WorkerStream;
+
+    struct StreamTag : Tag {
+        StreamTag(Kind kind, WorkerStream* stream) : Tag(kind), stream(stream) {}
+        WorkerStream* stream;
+    };
+
+    // One ProcessChunks stream. At most one write and one read are
+    // outstanding at a time; further frames wait in writeQueue.
+    struct WorkerStream {
+        explicit WorkerStream(size_t workerIndex);
+
+        size_t workerIndex;
+        ChannelPool::Lease channel;  // Connection the request runs on
+        grpc::ClientContext context;
+        std::unique_ptr<grpc::GenericClientAsyncReaderWriter> stream;
+        grpc::ByteBuffer reply;
+        grpc::Status status;
+        std::deque<grpc::ByteBuffer> writeQueue;  // Encoded ChunkRequest frames
+        std::unordered_map<uint64_t, StreamedChunk> pending;  // By chunk index, until its result arrives
+
+        bool started = false;
+        bool writing = false;
+        bool writesDone = false;
+        bool readClosed = false;
+        bool finishing = false;
+        bool finished = false;
+        size_t opsPending = 0;
+
+        StreamTag startTag;
+        StreamTag readTag;
+        StreamTag writeTag;
+        StreamTag writesDoneTag;
+        StreamTag finishTag;
+    };
+
+    size_t workerCount() const { return workers_.size(); }
+    bool isLocal(size_t workerIndex) const { return localPool_ && workerIndex == localIndex_; }
+    bool isRemote(size_t workerIndex) const { return workerIndex < workers_.size() && workers_[workerIndex]; }
+    bool sharedStorage() const { return !sharedInput_.empty(); }
+    bool retiring(size_t workerIndex) const { return memberStates_[workerIndex] != MemberState::Active; }
+    void syncMembership();
+    void startAttempt(FileChunk&& chunk, size_t index, size_t workerIndex,
+                      ChunkOperation operation, const std::string& key, const std::string& iv);
+    void startCall(FileChunk&& chunk, size_t index, size_t workerIndex,
+                   ChunkOperation operation, const std::string& key, const std::string& iv);
+    void startLocal(FileChunk&& chunk, size_t index, ChunkOperation operation,
+                    const std::string& key, const std::string& iv);
+    void trackAttempt(size_t index, size_t workerIndex, const FileChunk* input, PendingCall* call);
+    void dropAttempt(size_t index);
+    double hedgeThresholdMs() const;
+    void startProbe(size_t workerIndex);
+    bool reserveBudget();
+    void releaseBudget(size_t chunks);
+    void startBatch(BatchItems&& items, size_t workerIndex,
+                    ChunkOperation operation, const std::string& key, const std::string& iv);
+    void cancelOutstanding();
+    void fillRequest(encryption::ChunkRequest& request, const FileChunk& chunk, size_t workerIndex,
+                     const std::string& key, const std::string& iv, bool withData = true) const;
+    grpc::ByteBuffer encodeRequest(FileChunk& chunk, const encryption::ChunkRequest& fields);
+    WorkerScheduler& activeScheduler() { return scheduler_ ? *scheduler_ : ownScheduler_; }
+    void openStreams();
+    WorkerStream* streamFor(size_t workerIndex);
+    void sendOnStream(WorkerStream& stream, FileChunk&& chunk, size_t index,
+                      ChunkOperation operation, const std::string& key, const std::string& iv);
+    void pumpStream(WorkerStream& stream, bool sourceDone);
+    // Each issues its calls to every worker at once and returns by the deadline
+    void openSessions(const std::string& key, const std::string& iv,
+                      std::chrono::system_clock::time_point deadline);
+    void closeSessions(std::chrono::system_clock::time_point deadline);
+    void attachRings(std::chrono::system_clock::time_point deadline);
+    void detachRings(std::chrono::system_clock::time_point deadline);
+    void finishRingCall(PendingCall& call, grpc::Status& status);
+
+    std::vector<std::shared_ptr<ChannelPool>> workers_;  // Null where there is no remote worker
+    size_t localIndex_ = 0;
+    size_t maxInFlightPerWorker_;
+    std::chrono::seconds callTimeout_{30};
+    CipherMode cipherMode_ = CipherMode::AES_256_CBC;
+    double hedgePercentile_ = 0;
+    size_t maxRetries_ = 3;
+    std::chrono::milliseconds retryBackoff_{200};
+    MemoryBudget* memoryBudget_ = nullptr;
+    uint64_t budgetPerChunk_ = 0;
+    LocalCryptoPool* localPool_ = nullptr;
+    bool localOnly_ = false;
+    FairShare* fairShare_ = nullptr;
+    size_t fairShareId_ = 0;
+    const std::atomic<bool>* cancelled_ = nullptr;
+    WorkerMembership* membership_ = nullptr;
+    uint64_t membershipVersion_ = 0;
+    std::string sharedInput_;   // Empty unless in shared-storage mode
+    std::string sharedOutput_;
+    WorkerScheduler* scheduler_ = nullptr;
+    WorkerScheduler ownScheduler_;
+    bool useSessions_ = true;
+    bool useStreaming_ = true;
+    size_t maxBatchChunks_ = 1;
+    size_t maxBatchBytes_ = 4 * 1024 * 1024;
+
+    std::unique_ptr<grpc::CompletionQueue> cq_;
+    std::vector<size_t> inFlight_;
+    std::vector<size_t> capacity_;  // Requests each worker may have outstanding
+    std::vector<size_t> baseCapacity_;  // Same, before the fair share is applied
+    size_t reservedChunks_ = 0;     // Budget shares currently held
+    uint64_t bytesMoved_ = 0;       // Chunk bytes sent and received this dispatch
+    uint64_t bytesCopied_ = 0;      // Chunk bytes copied in memory on the way
+    ArenaStats arenaStats_;         // Protobuf allocation this dispatch
+    CallArena requestFrames_{&arenaStats_};   // Stream frames being encoded, reset per frame
+    CallArena responseFrames_{&arenaStats_};  // Stream frames being handled, reset per frame
+    std::unordered_set<PendingCall*> outstanding_;
+    std::unordered_set<PendingBatch*> outstandingBatches_;
+    std::vector<bool> batchUnsupported_;  // Workers that answered UNIMPLEMENTED to a batch
+    std::vector<MemberState> memberStates_;  // As of the last membership sync
+    std::unordered_map<size_t, ChunkState> active_;  // Unsettled chunks by index
+    std::deque<double> latencySamples_;              // Recent chunk latencies (ms) for hedging
+    std::multimap<WorkerScheduler::Clock::time_point, RetryItem> retries_;  // By due time
+    std::unordered_set<PendingProbe*> probes_;
+    std::unordered_set<PendingLocal*> localOutstanding_;
+    std::vector<WorkerScheduler::Clock::time_point> probeDue_;  // Per worker; max() = none scheduled
+    std::vector<std::chrono::milliseconds> probeDelay_;
+    std::vector<uint64_t> sessions_;  // Per worker; 0 = send key material inline
+    std::vector<bool> sameHost_;
+    size_t ringSlotSize_ = 0;
+    std::vector<std::unique_ptr<SharedRing>> rings_;  // Per worker; null = chunks go in the request
+    std::vector<uint64_t> ringIds_;                   // The worker's id for each ring
+    std::vector<std::unique_ptr<WorkerStream>> streams_;  // One per connection; none = unary calls
+};
+
+#endif // DISPATCHER_H
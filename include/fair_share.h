@@ -0,0 +1,29 @@
+// fair_share.h
+#ifndef FAIR_SHARE_H
+#define FAIR_SHARE_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+
+// Splits the worker slots between jobs running side by side. Each job joins
+// with a weight and gets weight / (sum of the running jobs' weights) of every
+// worker's window; a job running alone gets all of it.
+class FairShare {
+public:
+    // Returns the id the job is known by until it leaves
+    size_t join(double weight);
+    void leave(size_t id);
+
+    // Share of the slots the job currently gets, in (0, 1]
+    double fraction(size_t id) const;
+    size_t activeCount() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::map<size_t, double> weights_;
+    double totalWeight_ = 0;
+    size_t nextId_ = 1;
+};
+
+#endif // FAIR_SHARE_H
@@ -0,0 +1,166 @@
+// job_queue.h
+#ifndef JOB_QUEUE_H
+#define JOB_QUEUE_H
+
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "encryption.pb.h"
+#include "encryption.grpc.pb.h"
+#include "dispatcher.h"
+#include "fair_share.h"
+#include "master.h"
+#include "membership.h"
+
+enum class JobPriority {
+    Low,
+    Normal,
+    High
+};
+
+enum class JobState {
+    Queued,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled
+};
+
+struct JobSpec {
+    ChunkOperation operation = ChunkOperation::Encrypt;
+    std::string inputPath;
+    std::string outputPath;
+    std::string keyPath;  // Empty = <output>.key when encrypting, <input>.key when decrypting
+    JobPriority priority = JobPriority::Normal;
+};
+
+// Point-in-time view of a job
+struct JobInfo {
+    uint64_t id = 0;
+    JobSpec spec;
+    JobState state = JobState::Queued;
+    uint64_t chunksDone = 0;
+    uint64_t chunksTotal = 0;
+    std::string error;
+    std::chrono::milliseconds queued{0};
+    std::chrono::milliseconds running{0};
+};
+
+// Jobs of a long-running master. Up to maxRunning jobs run at once on one
+// EncryptionMaster, so they share its warm worker connections, scheduler
+// stats, local pool and memory budget. Queued jobs start highest priority
+// first, oldest first within a class; running jobs split every worker's
+// window by priority weight through a FairShare.
+class JobQueue {
+public:
+    JobQueue(EncryptionMaster& master, size_t maxRunning, size_t chunkSize);
+    ~JobQueue();  // Cancels running jobs and waits for them
+
+    JobQueue(const JobQueue&) = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+
+    uint64_t submit(const JobSpec& spec);
+
+    // False if the job is unknown; info is left untouched then
+    bool status(uint64_t id, JobInfo& info) const;
+
+    // Queued jobs are dropped at once, running ones stop at their next
+    // poll; false if the job is unknown or already finished
+    bool cancel(uint64_t id);
+
+    std::vector<JobInfo> list() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kMaxFinishedJobs = 256;  // Records kept for status queries
+
+    struct Job {
+        uint64_t id = 0;
+        JobSpec spec;
+        JobState state = JobState::Queued;
+        std::string error;
+        Clock::time_point submittedAt;
+        Clock::time_point startedAt;
+        Clock::time_point finishedAt;
+        JobControl control;
+    };
+
+    static double weight(JobPriority priority);
+
+    void runLoop();
+    void runJob(Job& job);
+    JobInfo describe(const Job& job) const;
+    void forgetFinished();
+
+    EncryptionMaster& master_;
+    size_t chunkSize_;
+    FairShare shares_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_ = false;
+    uint64_t nextId_ = 1;
+    std::map<uint64_t, std::shared_ptr<Job>> jobs_;           // By id, so in submission order
+    std::set<std::pair<int, uint64_t>> queued_;               // (-priority, id): next job first
+    std::vector<std::thread> runners_;
+};
+
+// MasterControl service in front of a JobQueue. Its callers name arbitrary
+// paths, so it is served on loopback only.
+class MasterControlService final : public encryption::MasterControl::Service {
+public:
+    explicit MasterControlService(JobQueue& jobs) : jobs_(jobs) {}
+
+    grpc::Status SubmitJob(grpc::ServerContext* context,
+                           const encryption::SubmitJobRequest* request,
+                           encryption::SubmitJobResponse* response) override;
+
+    grpc::Status GetJobStatus(grpc::ServerContext* context,
+                              const encryption::JobStatusRequest* request,
+                              encryption::JobStatus* response) override;
+
+    grpc::Status CancelJob(grpc::ServerContext* context,
+                           const encryption::CancelJobRequest* request,
+                           encryption::CancelJobResponse* response) override;
+
+    grpc::Status ListJobs(grpc::ServerContext* context,
+                          const encryption::ListJobsRequest* request,
+                          encryption::ListJobsResponse* response) override;
+
+private:
+    JobQueue& jobs_;
+};
+
+// WorkerRegistry service in front of the master's worker membership. A
+// registered worker is sent keys and data, so this is served with mutual TLS
+// (or on loopback only without TLS).
+class WorkerRegistryService final : public encryption::WorkerRegistry::Service {
+public:
+    explicit WorkerRegistryService(WorkerMembership& members) : members_(members) {}
+
+    grpc::Status RegisterWorker(grpc::ServerContext* context,
+                                const encryption::RegisterWorkerRequest* request,
+                                encryption::RegisterWorkerResponse* response) override;
+
+    grpc::Status Heartbeat(grpc::ServerContext* context,
+                           const encryption::HeartbeatRequest* request,
+                           encryption::HeartbeatResponse* response) override;
+
+    grpc::Status DeregisterWorker(grpc::ServerContext* context,
+                                  const encryption::DeregisterWorkerRequest* request,
+                                  encryption::DeregisterWorkerResponse* response) override;
+
+private:
+    WorkerMembership& members_;
+};
+
+#endif // JOB_QUEUE_H
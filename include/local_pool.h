@@ -0,0 +1,70 @@
+// local_pool.h
+#ifndef LOCAL_POOL_H
+#define LOCAL_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "crypto.h"
+
+// Fixed set of threads in the master that run crypto tasks in-process. The
+// dispatcher uses it as one more worker, next to the remote ones, so chunks
+// can be processed without a network round trip.
+//
+// Work stealing: each thread has its own deque. Tasks submitted from outside
+// are spread over the deques round robin, and tasks submitted from a pool
+// thread stay on its own deque. A thread takes from the front of its deque
+// and, when that is empty, steals from the back of another thread's, so a few
+// slow chunks never leave the other cores idle.
+class LocalCryptoPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads = 0 uses one thread per hardware thread. With pinThreads each
+    // thread is bound to its own core (wrapping past the core count), so the
+    // scheduler does not move hot AES state between cores.
+    explicit LocalCryptoPool(size_t threads = 0, bool pinThreads = false);
+    ~LocalCryptoPool();
+
+    LocalCryptoPool(const LocalCryptoPool&) = delete;
+    LocalCryptoPool& operator=(const LocalCryptoPool&) = delete;
+
+    size_t threadCount() const { return threads_.size(); }
+
+    // Runs the task on one of the pool threads
+    void submit(Task task);
+
+    // Tasks taken from another thread's deque so far
+    uint64_t steals() const { return steals_.load(); }
+
+    // Bytes per second a single thread of this machine encrypts with the given
+    // cipher, measured on first use and cached for the rest of the process
+    static double calibratedThroughput(CipherMode mode);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t self, bool pin);
+    bool take(size_t self, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<uint64_t> steals_{0};
+
+    // Tasks queued but not yet claimed by a thread; guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    size_t unclaimed_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+#endif // LOCAL_POOL_H
@@ -3,17 +3,39 @@
 #define MASTER_H
 
 #include <grpcpp/grpcpp.h>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <string>
 #include <mutex>
 #include "encryption.pb.h"
 #include "encryption.grpc.pb.h"
+#include "channel_registry.h"
 #include "chunk.h"
+#include "dispatcher.h"
+#include "container.h"
+#include "fair_share.h"
+#include "local_pool.h"
+#include "membership.h"
+#include "memory_budget.h"
+#include "scheduler.h"
+
+// Hooks for a job run alongside others on one master (see JobQueue): its
+// share of the workers, a flag that cancels it and its progress
+struct JobControl {
+    FairShare* shares = nullptr;
+    size_t shareId = 0;
+    std::atomic<bool> cancelled{false};
+    std::atomic<uint64_t> chunksDone{0};
+    std::atomic<uint64_t> chunksTotal{0};
+};
 
 class EncryptionMaster {
 public:
-    EncryptionMaster(const std::vector<std::string>& workerAddresses, bool useTLS = false);    
+    // connectionsPerWorker > 1 opens that many separate HTTP/2 connections to
+    // each worker and spreads requests over them
+    EncryptionMaster(const std::vector<std::string>& workerAddresses, bool useTLS = false,
+                     size_t connectionsPerWorker = 1);
     
     std::vector<FileChunk> encryptFile(const std::string& filePath, 
                                      size_t chunkSize, 
@@ -25,19 +47,111 @@ public:
                                         const std::string& key,
                                         const std::string& iv);
        
+    // Streaming variants: read, dispatch and write chunk by chunk so memory use
+    // is bounded by the in-flight window rather than the file size. Encryption
+    // produces a framed container (see container.h); decryption accepts both
+    // containers and unframed files from older versions. Several can run at
+    // once on one master, each with its own JobControl.
+    bool encryptFileTo(const std::string& inputPath,
+                       const std::string& outputPath,
+                       size_t chunkSize,
+                       const std::string& key,
+                       const std::string& iv,
+                       JobControl* job = nullptr);
+
+    bool decryptFileTo(const std::string& inputPath,
+                       const std::string& outputPath,
+                       size_t chunkSize,
+                       const std::string& key,
+                       const std::string& iv,
+                       JobControl* job = nullptr);
+       
+    // Pings every worker. Workers that do not answer are taken out of rotation
+    // (and probed again during jobs); returns false only if none answer and
+    // there is no local pool to fall back on.
     bool testWorkerConnections();
     
     // New method for writing processed data to files
     bool writeProcessedDataToFile(const std::string& outputPath, const std::vector<FileChunk>& chunks);
 
+    // Number of requests kept outstanding on each worker during dispatch
+    void setMaxInFlightPerWorker(size_t maxInFlight) { maxInFlightPerWorker_ = maxInFlight; }
+
+    // Stream chunks to each worker over ProcessChunks (default) rather than
+    // making one unary call per chunk
+    void setUseStreaming(bool useStreaming) { useStreaming_ = useStreaming; }
+
+    // Pack small chunks into EncryptBatch/DecryptBatch calls of up to
+    // maxChunks chunks and maxBytes of payload (maxChunks = 1 disables batching)
+    void setBatchLimits(size_t maxChunks, size_t maxBytes) {
+        maxBatchChunks_ = maxChunks;
+        maxBatchBytes_ = maxBytes;
+    }
+
+    // Times a failed chunk is retried on another worker before the job fails
+    void setMaxRetries(size_t maxRetries) { maxRetries_ = maxRetries; }
+
+    // Resend chunks outstanding longer than this latency percentile to an
+    // idle worker and keep whichever result arrives first (0 = off)
+    void setHedgePercentile(double percentile) { hedgePercentile_ = percentile; }
+
+    // Also process chunks in-process on this many threads (0 = one per
+    // hardware thread). A cost model decides per file whether the remote
+    // workers are worth using; per chunk, the scheduler weighs the pool
+    // against the workers by measured throughput.
+    void setLocalThreads(size_t threads);
+
+    // Bound the chunk data held by streaming jobs. Masters given the same
+    // budget share it, so concurrent jobs stay within it together.
+    void setMemoryBudget(std::shared_ptr<MemoryBudget> budget) { memoryBudget_ = std::move(budget); }
+
+    // The workers this master uses. Workers can register with it and leave
+    // while it runs; jobs pick the changes up as they go.
+    WorkerMembership& membership() { return *membership_; }
+
+    // Per-worker chunk counts, latency and throughput gathered so far
+    std::vector<WorkerStats> workerStats() const { return scheduler_.stats(); }
+
+    // For a master and workers that mount the same storage at the same path:
+    // encryptFileTo/decryptFileTo send workers only the file ranges to
+    // process and workers read and write the files themselves, so the master
+    // just plans the layout and writes the header, index and footer
+    void setSharedStorage(bool sharedStorage) { sharedStorage_ = sharedStorage; }
+
+    // Workers found on this host by testWorkerConnections get chunk data
+    // through a shared-memory ring rather than over the loopback (on by default)
+    void setUseSharedMemory(bool useSharedMemory) { useSharedMemory_ = useSharedMemory; }
+
+    // Cipher used by encryptFileTo; decryption always follows the container header
+    void setCipherMode(CipherMode mode) { cipherMode_ = mode; }
+
 private:
-    std::vector<std::unique_ptr<encryption::EncryptionService::Stub>> stubs_;
     bool useTLS_;
+    std::shared_ptr<WorkerMembership> membership_;
+    size_t maxInFlightPerWorker_ = 4;
+    CipherMode cipherMode_ = CipherMode::AES_256_CBC;
+    bool useStreaming_ = true;
+    bool sharedStorage_ = false;
+    bool useSharedMemory_ = true;
+    size_t maxBatchChunks_ = 1;
+    size_t maxBatchBytes_ = 4 * 1024 * 1024;
+    double hedgePercentile_ = 0;
+    size_t maxRetries_ = 3;
+    std::unique_ptr<LocalCryptoPool> localPool_;
+    std::shared_ptr<MemoryBudget> memoryBudget_;
+    std::vector<double> rttMs_;  // TestConnection round trip per worker
+    std::vector<bool> sameHost_; // Per worker: same host and logon session as the master
+    WorkerScheduler scheduler_;  // Shared by every dispatch so measurements carry over
     std::mutex mutex_; // For thread-safe operations
 
     // Helper methods
-    std::shared_ptr<grpc::Channel> createChannel(const std::string& address);
-    void initializeStubs(const std::vector<std::string>& workerAddresses);
+    ContainerLayout planDecryption(const std::string& inputPath, size_t chunkSize);
+    bool preferLocal(uint64_t bytes, CipherMode mode) const;
+    void configureDispatcher(ChunkDispatcher& dispatcher, uint64_t bytes, size_t chunkSize, CipherMode mode,
+                             JobControl* job = nullptr);
+
+    static constexpr double kAssumedLinkBytesPerSecond = 100.0 * 1024 * 1024;
+    static constexpr double kAssumedRttMs = 1.0;
 };
 
 #endif // MASTER_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+// membership.h
+#ifndef MEMBERSHIP_H
+#define MEMBERSHIP_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "channel_registry.h"
+
+enum class MemberState {
+    Active,
+    Draining,  // Finishes what it has but takes no new chunks
+    Gone       // Deregistered or silent; anything still outstanding on it is resent
+};
+
+struct WorkerMember {
+    std::string address;                 // Empty for the local pool's slot
+    std::shared_ptr<ChannelPool> pool;   // Null for the local pool's slot
+    MemberState state = MemberState::Active;
+    bool registered = false;             // Joined through RegisterWorker and must keep sending heartbeats
+    size_t capacity = 0;                 // Requests the worker says it can run at once; 0 = unknown
+    size_t queueDepth = 0;               // Chunks it was running at its last heartbeat
+    std::chrono::steady_clock::time_point lastHeartbeat;
+};
+
+// The workers a master knows about. Indices are stable for the life of the
+// master and double as the scheduler's worker indices: workers that join
+// later are appended, and one that leaves keeps its index and gets it back
+// if it registers again. Registered workers must send heartbeats; one that is
+// silent for longer than the timeout is dropped. Workers named on the command
+// line send none and are left to the circuit breaker instead.
+class WorkerMembership {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds kDefaultHeartbeatTimeout{10000};
+
+    WorkerMembership(bool useTLS, size_t connectionsPerWorker,
+                     std::chrono::milliseconds heartbeatTimeout = kDefaultHeartbeatTimeout);
+
+    // A worker from the command line
+    size_t add(const std::string& address);
+
+    // The local pool's slot; it has no pool and is never dropped
+    size_t addLocal();
+
+    // A worker that announced itself; returns its index
+    size_t registerWorker(const std::string& address, size_t capacity);
+
+    // False if the worker is unknown or was dropped, so it should register again
+    bool heartbeat(const std::string& address, size_t queueDepth, size_t capacity);
+
+    // Takes the worker out of rotation once its outstanding chunks are done;
+    // false if it is unknown
+    bool drain(const std::string& address);
+
+    // Changes whenever a worker joins, drains or is dropped. Silent workers
+    // are dropped here, so callers polling it notice them.
+    uint64_t version();
+
+    std::vector<WorkerMember> snapshot();
+
+    // Connection pools by index (null for the local slot)
+    std::vector<std::shared_ptr<ChannelPool>> pools() const;
+
+    size_t size() const;
+
+    // How often registered workers should send heartbeats
+    std::chrono::milliseconds heartbeatInterval() const { return heartbeatTimeout_ / 3; }
+
+private:
+    size_t findLocked(const std::string& address) const;
+    void expireLocked(Clock::time_point now);
+
+    bool useTLS_;
+    size_t connectionsPerWorker_;
+    std::chrono::milliseconds heartbeatTimeout_;
+
+    mutable std::mutex mutex_;
+    std::vector<WorkerMember> members_;
+    uint64_t version_ = 0;
+};
+
+#endif // MEMBERSHIP_H
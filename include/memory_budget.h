@@ -0,0 +1,32 @@
+// memory_budget.h
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <cstdint>
+#include <mutex>
+
+// Byte-counting semaphore bounding how much chunk data is held in memory.
+// Several jobs can share one budget, so the total across them stays put no
+// matter how many run at once.
+class MemoryBudget {
+public:
+    explicit MemoryBudget(uint64_t capacity);
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    // Reserves bytes if they fit. A request larger than the whole budget is
+    // granted once nothing else is reserved, so it still makes progress.
+    bool tryAcquire(uint64_t bytes);
+    void release(uint64_t bytes);
+
+    uint64_t capacity() const { return capacity_; }
+    uint64_t inUse() const;
+
+private:
+    const uint64_t capacity_;
+    mutable std::mutex mutex_;
+    uint64_t used_ = 0;
+};
+
+#endif // MEMORY_BUDGET_H
@@ -0,0 +1,82 @@
+// scheduler.h
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Observed performance of one worker
+struct WorkerStats {
+    uint64_t chunks = 0;             // Chunks completed successfully
+    uint64_t bytes = 0;              // Input bytes of those chunks
+    uint64_t failures = 0;
+    uint64_t consecutiveFailures = 0; // Transport failures since the last success
+    bool available = true;           // False while the circuit breaker has the worker out
+    double latencyMs = 0;            // EWMA of send-to-result time per request
+    double throughput = 0;           // EWMA of bytes per second; 0 until the first completion
+};
+
+// Picks the worker for the next chunk from measured throughput. Chunks stay in
+// the shared source until some worker has a free slot, so workers effectively
+// pull work; among the free ones the chunk goes to the worker expected to
+// finish it soonest, so a fast worker takes proportionally more of the file.
+// Stats persist across jobs so later jobs start from what was learned.
+//
+// Each worker also has a circuit breaker: after kFailureThreshold consecutive
+// transport failures it stops being picked until markAvailable() is called,
+// which the dispatcher does once the worker answers TestConnection again.
+class WorkerScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit WorkerScheduler(size_t workerCount = 0);
+
+    void resize(size_t workerCount);
+    size_t size() const;
+
+    // Index of the available worker that should take the next chunk, given the
+    // requests each one has outstanding, or size() if every available worker
+    // is at maxInFlight
+    size_t pick(const std::vector<size_t>& inFlight, size_t maxInFlight) const;
+
+    // Same, with a separate request limit per worker (0 = never pick it)
+    size_t pick(const std::vector<size_t>& inFlight, const std::vector<size_t>& capacity) const;
+
+    // Starting estimate for a worker that has not completed anything yet
+    void setExpectedThroughput(size_t worker, double bytesPerSecond);
+
+    // Records a successful request of `bytes` input bytes sent at sentAt
+    void recordCompletion(size_t worker, uint64_t bytes, size_t chunks, Clock::time_point sentAt);
+
+    // Records a failed request. Transport failures (the worker could not be
+    // reached or did not answer) count toward the circuit breaker; returns true
+    // when this failure took the worker out of rotation.
+    bool recordFailure(size_t worker, bool transport = true);
+
+    bool available(size_t worker) const;
+    size_t availableCount() const;
+    void markAvailable(size_t worker);
+    void markUnavailable(size_t worker);
+
+    std::vector<WorkerStats> stats() const;
+
+    // One line per worker with its share of the chunks and its rates
+    std::string summary() const;
+
+private:
+    static constexpr double kAlpha = 0.2;  // EWMA weight of the newest sample
+    static constexpr uint64_t kFailureThreshold = 3;
+
+    struct Entry {
+        WorkerStats stats;
+        Clock::time_point lastCompletion;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> workers_;
+};
+
+#endif // SCHEDULER_H
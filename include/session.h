@@ -0,0 +1,53 @@
+// session.h
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "crypto.h"
+
+// Key material registered by a master through OpenSession
+struct WorkerSession {
+    WorkerSession(CipherMode mode, const std::string& key, const std::string& iv);
+    ~WorkerSession();
+
+    CipherMode mode;
+    std::string key;
+    std::string iv;  // IV, or the file nonce for GCM
+};
+
+// Bounded, thread-safe LRU of open sessions on a worker. Masters that never
+// call CloseSession (crashes, lost connections) cannot grow it without bound;
+// the least recently used session is evicted once the capacity is reached.
+// The expanded key schedules themselves live in the per-thread cipher
+// context cache (AESCrypto::context), keyed by the session's key.
+class SessionStore {
+public:
+    explicit SessionStore(size_t capacity = 64);
+
+    // Registers a session and returns its id (random, never 0)
+    uint64_t open(CipherMode mode, const std::string& key, const std::string& iv);
+
+    // Returns false if the session is unknown or was already evicted
+    bool close(uint64_t id);
+
+    // Looks up a session and marks it as recently used; null if unknown.
+    // The returned session stays valid even if it is evicted meanwhile.
+    std::shared_ptr<const WorkerSession> find(uint64_t id);
+
+    size_t size() const;
+
+private:
+    using Entry = std::pair<uint64_t, std::shared_ptr<const WorkerSession>>;
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;  // Most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+};
+
+#endif // SESSION_H
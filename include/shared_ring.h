@@ -0,0 +1,90 @@
+// shared_ring.h
+#ifndef SHARED_RING_H
+#define SHARED_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Same-host data plane between a master and a worker: a named shared-memory
+// mapping split into fixed-size slots. The master copies a chunk into a free
+// slot and sends only its offset over gRPC; the worker processes it in place
+// and answers with the output length, and the master copies the result out.
+// Chunk bytes never cross the loopback socket, HTTP/2 framing or protobuf.
+//
+// Slots are handed out in ring order from a free list, since results come
+// back out of order. A slot whose call did not complete cleanly may still be
+// written by the worker, so it is retired rather than reused.
+class SharedRing {
+public:
+    static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+
+    // Every ring's name starts with this; workers map nothing else
+    static constexpr const char* kNamePrefix = "Local\\DistributedEncryption-";
+
+    // Master side: a new uniquely named mapping of slots x slotSize bytes
+    SharedRing(size_t slots, size_t slotSize);
+
+    // Worker side: maps the master's region by name. Throws
+    // std::invalid_argument for a name that is not a ring's or a size larger
+    // than the region.
+    SharedRing(const std::string& name, uint64_t size);
+
+    ~SharedRing();
+
+    SharedRing(const SharedRing&) = delete;
+    SharedRing& operator=(const SharedRing&) = delete;
+
+    const std::string& name() const { return name_; }
+    uint64_t size() const { return size_; }
+    char* data() { return view_; }
+
+    size_t slotSize() const { return slotSize_; }
+    uint64_t slotOffset(size_t slot) const { return static_cast<uint64_t>(slot) * slotSize_; }
+    char* slotData(size_t slot) { return view_ + slotOffset(slot); }
+
+    // kNoSlot when every slot is in use. Retired slots are simply never released.
+    size_t acquire();
+    void release(size_t slot);
+
+    // Identifies this host and logon session: processes with the same
+    // identity can open each other's mappings
+    static std::string hostIdentity();
+
+private:
+    void map(size_t length);
+
+    std::string name_;
+    uint64_t size_ = 0;
+    size_t slotSize_ = 0;
+    void* mapping_ = nullptr;  // HANDLE
+    char* view_ = nullptr;
+    std::mutex mutex_;
+    std::deque<size_t> free_;
+};
+
+// Rings a worker has attached, by id. Masters detach theirs at the end of
+// each job; a worker holds at most capacity, dropping the oldest beyond that.
+class SharedRingStore {
+public:
+    explicit SharedRingStore(size_t capacity = 16) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    // Maps the ring and returns its id (random, never 0)
+    uint64_t attach(const std::string& name, uint64_t size);
+    bool detach(uint64_t id);
+
+    // Null if unknown; the ring stays mapped while the caller holds it
+    std::shared_ptr<SharedRing> find(uint64_t id);
+
+private:
+    size_t capacity_;
+    std::mutex mutex_;
+    std::deque<uint64_t> order_;  // Oldest first
+    std::unordered_map<uint64_t, std::shared_ptr<SharedRing>> rings_;
+};
+
+#endif // SHARED_RING_H
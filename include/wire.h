@@ -0,0 +1,43 @@
+// wire.h
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "encryption.pb.h"
+
+// Chunk messages in protobuf wire format, built and read straight from
+// grpc::ByteBuffer slices for use with grpc::GenericStub. Workers still see
+// ordinary ChunkRequest/ChunkResponse messages; only the master's side of
+// the payload avoids protobuf's copies.
+//
+// With the generated stubs a chunk's bytes are copied into the request's
+// data string and again into the serialized message, and a result is copied
+// out of the received message and again into the FileChunk. Here the request
+// references the chunk's own buffer in a slice that keeps it alive for as
+// long as gRPC holds it, and the result is copied once, from the received
+// slices into its vector.
+class ChunkWire {
+public:
+    // Full method names for GenericStub calls
+    static const char* const kEncryptChunk;
+    static const char* const kDecryptChunk;
+    static const char* const kProcessRange;
+    static const char* const kProcessChunks;
+
+    // The request's fields (data left empty) followed by payload as its data
+    // field, without copying the payload. Payload may be null.
+    static grpc::ByteBuffer encodeRequest(const encryption::ChunkRequest& fields,
+                                          const std::shared_ptr<const std::vector<char>>& payload);
+
+    // Reads a ChunkResponse, placing processed_data in output rather than in
+    // the message; false if the buffer is not a valid message
+    static bool decodeResponse(const grpc::ByteBuffer& buffer,
+                               encryption::ChunkResponse& fields,
+                               std::vector<char>& output);
+};
+
+#endif // WIRE_H
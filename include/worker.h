@@ -2,25 +2,151 @@
 #define WORKER_H
 
 #include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <windows.h>
 #include "encryption.pb.h"
 #include "encryption.grpc.pb.h"
+#include "arena.h"
+#include "local_pool.h"
+#include "session.h"
+#include "shared_ring.h"
 
-class EncryptionWorker final : public encryption::EncryptionService::Service {
+// Thread counts of a worker server (0 = one per hardware thread)
+struct WorkerThreads {
+    size_t cryptoThreads = 0;  // Crypto pool, each thread pinned to its own core
+};
+
+// Callback-based worker: RPC handlers only hand chunks to a fixed crypto pool
+// and return, and the pool thread that finishes a chunk completes its RPC, so
+// gRPC's threads do network work only and crypto runs on exactly
+// cryptoThreads threads however many calls arrive. Unary request and
+// response messages are allocated on per-RPC arenas (ArenaMessageAllocator).
+class EncryptionWorker final : public encryption::EncryptionService::CallbackService {
 public:
-    grpc::Status EncryptChunk(grpc::ServerContext* context, 
-                             const encryption::ChunkRequest* request, 
-                             encryption::ChunkResponse* response) override;
-    
-    grpc::Status DecryptChunk(grpc::ServerContext* context,
-                             const encryption::ChunkRequest* request,
-                             encryption::ChunkResponse* response) override;
-    
-    void runServer(const std::string& serverAddress, bool useTLS = false);
-
-    grpc::Status TestConnection(
-        grpc::ServerContext* context,
-        const encryption::TestRequest* request,
-        encryption::TestResponse* response);
+    EncryptionWorker();
+    ~EncryptionWorker();
+
+    grpc::ServerUnaryReactor* EncryptChunk(grpc::CallbackServerContext* context,
+                                           const encryption::ChunkRequest* request,
+                                           encryption::ChunkResponse* response) override;
+
+    grpc::ServerUnaryReactor* DecryptChunk(grpc::CallbackServerContext* context,
+                                           const encryption::ChunkRequest* request,
+                                           encryption::ChunkResponse* response) override;
+
+    // Batches are processed in one pass: the session is resolved and the key
+    // schedule looked up once, then every entry runs back to back
+    grpc::ServerUnaryReactor* EncryptBatch(grpc::CallbackServerContext* context,
+                                           const encryption::BatchRequest* request,
+                                           encryption::BatchResponse* response) override;
+
+    grpc::ServerUnaryReactor* DecryptBatch(grpc::CallbackServerContext* context,
+                                           const encryption::BatchRequest* request,
+                                           encryption::BatchResponse* response) override;
+
+    // Frames are processed on the crypto pool; each result is written back as
+    // soon as it is ready
+    grpc::ServerBidiReactor<encryption::ChunkRequest, encryption::ChunkResponse>* ProcessChunks(
+        grpc::CallbackServerContext* context) override;
+
+    // Shared-storage chunks: reads the described input range and writes the
+    // result to the output file directly, returning only its length. Refused
+    // unless setSharedRoot was called, and for paths outside that root.
+    grpc::ServerUnaryReactor* ProcessRange(grpc::CallbackServerContext* context,
+                                           const encryption::ChunkRequest* request,
+                                           encryption::ChunkResponse* response) override;
+
+    void runServer(const std::string& serverAddress, bool useTLS = false,
+                   const WorkerThreads& threads = WorkerThreads());
+
+    // Join a master daemon: register with its worker registry at masterAddress
+    // as advertiseAddress (where the master can reach this worker) and send
+    // heartbeats while serving. With useTLS the worker authenticates with its
+    // server.crt/server.key. On Ctrl+C the worker deregisters, so the master
+    // drains it, and shuts down once its calls have finished.
+    void setMaster(const std::string& masterAddress, const std::string& advertiseAddress, bool useTLS = false);
+
+    // Directory holding the shared storage; ProcessRange only opens files
+    // under it. Throws if it is not an existing directory.
+    void setSharedRoot(const std::string& root);
+
+    grpc::ServerUnaryReactor* TestConnection(grpc::CallbackServerContext* context,
+                                             const encryption::TestRequest* request,
+                                             encryption::TestResponse* response) override;
+
+    grpc::ServerUnaryReactor* OpenSession(grpc::CallbackServerContext* context,
+                                          const encryption::OpenSessionRequest* request,
+                                          encryption::OpenSessionResponse* response) override;
+
+    grpc::ServerUnaryReactor* CloseSession(grpc::CallbackServerContext* context,
+                                           const encryption::CloseSessionRequest* request,
+                                           encryption::CloseSessionResponse* response) override;
+
+    // Same-host data plane: map a master's shared-memory ring, so its chunk
+    // requests can refer to data in the ring instead of carrying it
+    grpc::ServerUnaryReactor* AttachRing(grpc::CallbackServerContext* context,
+                                         const encryption::AttachRingRequest* request,
+                                         encryption::AttachRingResponse* response) override;
+
+    grpc::ServerUnaryReactor* DetachRing(grpc::CallbackServerContext* context,
+                                         const encryption::DetachRingRequest* request,
+                                         encryption::DetachRingResponse* response) override;
+
+private:
+    class ChunkStream;
+
+    using ChunkAllocator = ArenaMessageAllocator<encryption::ChunkRequest, encryption::ChunkResponse>;
+    using BatchAllocator = ArenaMessageAllocator<encryption::BatchRequest, encryption::BatchResponse>;
+
+    // Run on the crypto pool
+    void encryptChunk(const encryption::ChunkRequest* request, encryption::ChunkResponse* response);
+    void decryptChunk(const encryption::ChunkRequest* request, encryption::ChunkResponse* response);
+    void processRange(const encryption::ChunkRequest* request, encryption::ChunkResponse* response);
+    // Canonical form of a ProcessRange path; throws if it is outside the root
+    std::string sharedPath(const std::string& path) const;
+    void processBatch(CipherDirection direction,
+                      const encryption::BatchRequest* request,
+                      encryption::BatchResponse* response);
+
+    // Queues work on the crypto pool, counting its chunks in the queue depth,
+    // and finishes the RPC once it has run
+    grpc::ServerUnaryReactor* runOnPool(grpc::CallbackServerContext* context, size_t chunks,
+                                        std::function<void()> work);
+
+    std::unique_ptr<encryption::WorkerRegistry::Stub> registryStub() const;
+    void heartbeatLoop();
+    void stopHeartbeats();
+    void drainAndStop();
+    static BOOL WINAPI onConsoleCtrl(DWORD type);
+
+    static constexpr std::chrono::milliseconds kDefaultHeartbeatInterval{3000};
+    static constexpr std::chrono::seconds kDrainTimeout{60};
+    static EncryptionWorker* drainingWorker;
+
+    SessionStore sessions_;
+    SharedRingStore rings_;
+    std::unique_ptr<LocalCryptoPool> cryptoPool_;  // Created by runServer
+    ArenaStats arenaStats_;
+    ChunkAllocator chunkAllocator_{&arenaStats_};
+    BatchAllocator batchAllocator_{&arenaStats_};
+    std::atomic<size_t> activeChunks_{0};  // Chunks being processed or queued on the pool
+    std::string workerId_ = "worker";
+    double bytesPerSecond_ = 0;            // Measured at startup, all cores together
+    std::filesystem::path sharedRoot_;     // Canonical; empty = ProcessRange refused
+    std::string masterAddress_;
+    std::string advertiseAddress_;
+    bool masterTLS_ = false;
+    grpc::Server* server_ = nullptr;
+    std::mutex heartbeatMutex_;
+    std::condition_variable heartbeatStopped_;
+    bool stopping_ = false;
 };
 
-#endif // WORKER_H
\ No newline at end of file
+#endif // WORKER_H
@@ -0,0 +1,75 @@
+// writer.h
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "chunk.h"
+
+// Compact record of which chunks have been written (one bit per chunk)
+class CompletionBitmap {
+public:
+    explicit CompletionBitmap(size_t count = 0);
+
+    void resize(size_t count);
+
+    // Marks a chunk as complete; returns false if it already was
+    bool set(size_t index);
+    bool test(size_t index) const;
+
+    size_t size() const { return count_; }
+    size_t completed() const { return completed_; }
+    bool all() const { return completed_ == count_; }
+
+    // Index of the first incomplete chunk, or size() if every chunk is done
+    size_t firstMissing() const;
+
+private:
+    std::vector<uint64_t> words_;
+    size_t count_ = 0;
+    size_t completed_ = 0;
+};
+
+// Output sink that writes each chunk straight to its final offset as soon as
+// it is available, so chunks can complete in any order without being copied,
+// sorted or buffered first.
+class PositionalFileWriter {
+public:
+    // With shared set, other processes (workers in shared-storage mode) may
+    // open the file and write chunks into it while it is open here
+    PositionalFileWriter(const std::string& path, size_t chunkCount, bool shared = false);
+    ~PositionalFileWriter();
+
+    PositionalFileWriter(const PositionalFileWriter&) = delete;
+    PositionalFileWriter& operator=(const PositionalFileWriter&) = delete;
+
+    // Writes raw bytes at an absolute offset (pwrite-style, thread-safe)
+    void writeAt(uint64_t offset, const char* data, size_t size);
+
+    // Writes a chunk at its offset and records it in the completion bitmap
+    void writeChunk(size_t index, uint64_t offset, const std::vector<char>& data);
+
+    // Records a chunk of the given size that someone else wrote in place
+    void recordChunk(size_t index, size_t size);
+
+    // Writes a set of chunks in id order without sorting or copying them
+    void writeChunks(const std::vector<FileChunk>& chunks);
+
+    bool isComplete() const;
+    size_t completedChunks() const;
+    uint64_t bytesWritten() const;
+
+    // Flushes and closes the file; returns false if anything failed
+    bool close();
+
+private:
+    std::string path_;
+    void* handle_;
+    mutable std::mutex mutex_;
+    CompletionBitmap completed_;
+    uint64_t bytesWritten_ = 0;
+};
+
+#endif // WRITER_H
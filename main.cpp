@@ -12,6 +12,7 @@
 #include <ctime>
 #include <grpcpp/grpcpp.h>
 #include "master.h"
+#include "job_queue.h"
 #include "worker.h"
 #include "chunk.h"
 #include "crypto.h"
@@ -27,6 +28,8 @@ namespace fs = std::filesystem;
 
 const string DEFAULT_WORKER_PORT = "50051";
 const size_t DEFAULT_CHUNK_SIZE = 1024 * 1024; // 1MB
+const string DEFAULT_CONTROL_ADDRESS = "127.0.0.1:50060";
+const string DEFAULT_REGISTRY_ADDRESS = "127.0.0.1:50061";
 
 // Global log file (static to ensure it persists)
 static ofstream debugLogFile;
@@ -130,10 +133,33 @@ bool verifyFileExists(const string& filePath, size_t& fileSize) {
 void printHelp() {
     cout << "Distributed Encryption System\n";
     cout << "Usage:\n";
-    cout << "  To run as worker: ./program worker <address:port> [--tls]\n";
+    cout << "  To run as worker: ./program worker <address:port> [--master <address:port> [--advertise <address:port>]] [--tls]\n";
+    cout << "                    [--crypto-threads <n>]  (crypto threads are pinned, one per core by default)\n";
+    cout << "                    [--shared-root <dir>]  serve --shared-storage masters, for files under dir only\n";
     cout << "  To run as master: ./program master <input> <output> <worker1> [worker2...] [--tls]\n";
     cout << "  To encrypt: ./program encrypt <input> <output> <worker1> [worker2...] [--tls]\n";
     cout << "  To decrypt: ./program decrypt <input> <output> <worker1> [worker2...] [--tls]\n";
+    cout << "  To run on this host only: ./program local <encrypt|decrypt> <input> <output> [--threads <n>] [--cipher <cbc|gcm>] [--memory-budget <MB>]\n";
+    cout << "  To run as a master daemon: ./program master-daemon [worker1 worker2...] [--listen <address:port>] [--registry <address:port>]\n";
+    cout << "                             [--jobs <n>] [--tls]  (jobs are submitted on --listen, a loopback address, default " << DEFAULT_CONTROL_ADDRESS << ";\n";
+    cout << "                             workers started with --master join on --registry, default " << DEFAULT_REGISTRY_ADDRESS << ". To accept\n";
+    cout << "                             workers from other hosts, use --registry 0.0.0.0:50061 with --tls: workers then need a\n";
+    cout << "                             certificate signed by ca.crt, and use their server.crt/server.key to register)\n";
+    cout << "  To use a master daemon: ./program job submit <encrypt|decrypt> <input> <output> [--priority <low|normal|high>] [--key <file>]\n";
+    cout << "                          ./program job <status|cancel> <id>, ./program job list  (all take [--daemon <address:port>])\n";
+    cout << "  Options: --inflight <n>  requests kept in flight per worker (default 4)\n";
+    cout << "           --cipher <cbc|gcm>  cipher for encryption (default cbc; gcm adds per-chunk authentication)\n";
+    cout << "           --connections <n>  separate connections per worker, for high-latency links (default 1)\n";
+    cout << "           --memory-budget <MB>  cap on chunk data held in memory; reading stalls until output drains\n";
+    cout << "           --unary  send one call per chunk instead of streaming chunks to each worker\n";
+    cout << "           --batch <n> [--batch-bytes <bytes>]  pack up to n small chunks per call (default 1, 4 MB)\n";
+    cout << "           --local-threads <n>  also encrypt in-process on n threads (0 = all cores); small files stay local\n";
+    cout << "           --retries <n>  retries of a failed chunk on other workers before giving up (default 3)\n";
+    cout << "           --hedge <pct>  resend chunks slower than this latency percentile to an idle worker (default off)\n";
+    cout << "           --shared-storage  input and output are on storage every worker mounts at the same path;\n";
+    cout << "                             workers read and write the file ranges and no chunk data passes through the master\n";
+    cout << "                             (the files must be under each worker's --shared-root)\n";
+    cout << "           --no-shared-memory  send chunks to workers on this host over gRPC instead of a shared-memory ring\n";
     cout << "  To configure Dropbox: ./program dropbox-config <access_token> [folder]\n";
     cout << "  To upload to Dropbox: ./program dropbox-upload <local_file> [dropbox_path]\n";
     cout << "  To download from Dropbox: ./program dropbox-download <dropbox_path> <local_file>\n";
@@ -144,12 +170,22 @@ void printHelp() {
     cout << "  Encrypt: ./program encrypt input.txt encrypted.bin 192.168.1.100:50051 --tls\n";
     cout << "  Configure Dropbox: ./program dropbox-config YOUR_ACCESS_TOKEN /encryption_files\n";
     cout << "  Upload to Dropbox: ./program dropbox-upload encrypted.bin /encryption_files/encrypted.bin\n";
+    cout << "  Daemon: ./program master-daemon 192.168.1.100:50051 192.168.1.101:50051 --jobs 4\n";
+    cout << "  Joining worker: ./program worker 0.0.0.0:50051 --master 192.168.1.10:50061 --advertise 192.168.1.102:50051 --tls\n";
+    cout << "  Submit: ./program job submit encrypt input.txt input.txt.encrypted --priority high\n";
 }
 
-void runWorker(const string& address, bool useTLS) {
+void runWorker(const string& address, bool useTLS, const string& masterAddress, const string& advertiseAddress,
+               const string& sharedRoot, const WorkerThreads& threads) {
     logMessage("Starting worker on " + address + (useTLS ? " (TLS enabled)" : ""));
     EncryptionWorker worker;
-    worker.runServer(address, useTLS);
+    if (!sharedRoot.empty()) {
+        worker.setSharedRoot(sharedRoot);
+    }
+    if (!masterAddress.empty()) {
+        worker.setMaster(masterAddress, advertiseAddress, useTLS);
+    }
+    worker.runServer(address, useTLS, threads);
 }
 
 // Function to handle Dropbox operations
@@ -250,81 +286,319 @@ bool handleDropboxOperation(const string& operation, int argc, char* argv[]) {
     return false;
 }
 
-// Simple client for connecting directly to worker services
-class EncryptionWorkerClient {
-public:
-    EncryptionWorkerClient(std::shared_ptr<grpc::Channel> channel)
-        : stub_(encryption::EncryptionService::NewStub(channel)) {}
-    
-    FileChunk EncryptChunk(const FileChunk& chunk, const std::string& key, const std::string& iv) {
-        encryption::ChunkRequest request;
-        request.set_data(chunk.data.data(), chunk.data.size());
-        request.set_chunk_id(chunk.id);
-        request.set_key(key.data(), key.size());
-        request.set_iv(iv.data(), iv.size());
-        
-        encryption::ChunkResponse response;
-        grpc::ClientContext context;
-        
-        // Set a timeout for the operation
-        auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(10);
-        context.set_deadline(deadline);
-        
-        grpc::Status status = stub_->EncryptChunk(&context, request, &response);
-        
-        if (!status.ok() || !response.success()) {
-            std::string error = "Encryption failed on worker";
-            if (!status.ok()) {
-                error += ": gRPC error: " + status.error_message();
-            } else {
-                error += ": " + response.error_message();
-            }
-            throw std::runtime_error(error);
+// Tuning options for master runs, set from the command line
+struct MasterOptions {
+    size_t maxInFlight = 4;
+    size_t connectionsPerWorker = 1;
+    CipherMode cipherMode = CipherMode::AES_256_CBC;
+    bool streaming = true;
+    size_t batchChunks = 1;
+    size_t batchBytes = 4 * 1024 * 1024;
+    double hedgePercentile = 0;
+    size_t maxRetries = 3;
+    bool useLocal = false;
+    size_t localThreads = 0;
+    uint64_t memoryBudget = 0;  // Bytes; 0 = unbounded
+    bool sharedStorage = false;
+    bool sharedMemory = true;
+};
+
+// Parses the tuning option at argv[i], if it is one, moving i past its value
+bool parseMasterOption(int argc, char* argv[], int& i, MasterOptions& options) {
+    string arg(argv[i]);
+    if (arg == "--inflight" && i + 1 < argc) {
+        options.maxInFlight = static_cast<size_t>(stoul(argv[++i]));
+        logMessage("Requests in flight per worker: " + to_string(options.maxInFlight));
+        return true;
+    }
+    if (arg == "--cipher" && i + 1 < argc) {
+        options.cipherMode = AESCrypto::parseCipherMode(argv[++i]);
+        logMessage("Cipher: " + AESCrypto::cipherModeName(options.cipherMode));
+        return true;
+    }
+    if (arg == "--memory-budget" && i + 1 < argc) {
+        options.memoryBudget = stoull(argv[++i]) * 1024 * 1024;
+        logMessage("Memory budget: " + string(argv[i]) + " MB");
+        return true;
+    }
+    if (arg == "--connections" && i + 1 < argc) {
+        options.connectionsPerWorker = static_cast<size_t>(stoul(argv[++i]));
+        logMessage("Connections per worker: " + to_string(options.connectionsPerWorker));
+        return true;
+    }
+    if (arg == "--batch" && i + 1 < argc) {
+        options.batchChunks = static_cast<size_t>(stoul(argv[++i]));
+        logMessage("Chunks per batch: " + to_string(options.batchChunks));
+        return true;
+    }
+    if (arg == "--batch-bytes" && i + 1 < argc) {
+        options.batchBytes = static_cast<size_t>(stoull(argv[++i]));
+        logMessage("Bytes per batch: " + to_string(options.batchBytes));
+        return true;
+    }
+    if (arg == "--local-threads" && i + 1 < argc) {
+        options.useLocal = true;
+        options.localThreads = static_cast<size_t>(stoul(argv[++i]));
+        logMessage("Local crypto threads: " + string(options.localThreads == 0 ? "all cores" : argv[i]));
+        return true;
+    }
+    if (arg == "--retries" && i + 1 < argc) {
+        options.maxRetries = static_cast<size_t>(stoul(argv[++i]));
+        logMessage("Retries per chunk: " + to_string(options.maxRetries));
+        return true;
+    }
+    if (arg == "--hedge" && i + 1 < argc) {
+        options.hedgePercentile = stod(argv[++i]);
+        logMessage("Hedging chunks slower than p" + string(argv[i]) + " latency");
+        return true;
+    }
+    if (arg == "--unary") {
+        options.streaming = false;
+        logMessage("Streaming disabled, using one call per chunk");
+        return true;
+    }
+    if (arg == "--shared-storage") {
+        options.sharedStorage = true;
+        logMessage("Shared storage: workers read and write the files themselves");
+        return true;
+    }
+    if (arg == "--no-shared-memory") {
+        options.sharedMemory = false;
+        logMessage("Shared memory disabled, workers on this host get chunks over gRPC");
+        return true;
+    }
+    return false;
+}
+
+void configureMaster(EncryptionMaster& master, const MasterOptions& options) {
+    master.setMaxInFlightPerWorker(options.maxInFlight);
+    master.setCipherMode(options.cipherMode);
+    master.setUseStreaming(options.streaming);
+    master.setBatchLimits(options.batchChunks, options.batchBytes);
+    master.setHedgePercentile(options.hedgePercentile);
+    master.setMaxRetries(options.maxRetries);
+    master.setSharedStorage(options.sharedStorage);
+    master.setUseSharedMemory(options.sharedMemory);
+    if (options.useLocal) {
+        master.setLocalThreads(options.localThreads);
+    }
+    if (options.memoryBudget > 0) {
+        master.setMemoryBudget(std::make_shared<MemoryBudget>(options.memoryBudget));
+    }
+}
+
+// True for 127.x.x.x, localhost and [::1] addresses, with or without a port
+static bool isLoopbackAddress(const string& address) {
+    string host = address;
+    if (host.rfind("[::1]", 0) == 0) {
+        return true;
+    }
+    size_t colon = host.rfind(':');
+    if (colon != string::npos) {
+        host = host.substr(0, colon);
+    }
+    return host == "localhost" || host == "::1" || host.rfind("127.", 0) == 0;
+}
+
+// Keeps one master, and its worker connections, up for the life of the
+// process and runs the jobs submitted over the MasterControl API. Workers
+// register on a separate listener.
+void runMasterDaemon(const vector<string>& workerAddresses, bool useTLS, const MasterOptions& options,
+                     const string& listenAddress, const string& registryAddress, size_t maxJobs) {
+    // Job requests name arbitrary paths on this host and are not
+    // authenticated, so they are only taken from this host
+    if (!isLoopbackAddress(listenAddress)) {
+        throw runtime_error("The control API must listen on a loopback address, not " + listenAddress);
+    }
+    // A registered worker is sent keys and plaintext, so registrations from
+    // other hosts need a client certificate
+    if (!useTLS && !isLoopbackAddress(registryAddress)) {
+        throw runtime_error("Registering workers on " + registryAddress + " requires --tls");
+    }
+
+    logMessage("Starting master daemon with " + to_string(workerAddresses.size()) + " worker(s)");
+    EncryptionMaster master(workerAddresses, useTLS, options.connectionsPerWorker);
+    configureMaster(master, options);
+
+    logMessage("Testing connections to workers...");
+    if (!workerAddresses.empty() && !master.testWorkerConnections()) {
+        logMessage("Warning: no worker is reachable yet; jobs keep probing them", true);
+    }
+
+    JobQueue jobs(master, maxJobs, DEFAULT_CHUNK_SIZE);
+    MasterControlService controlService(jobs);
+    WorkerRegistryService registryService(master.membership());
+
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(listenAddress, grpc::InsecureServerCredentials());
+    builder.RegisterService(&controlService);
+    std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+    if (!server) {
+        throw runtime_error("Failed to start control server on " + listenAddress);
+    }
+
+    grpc::ServerBuilder registryBuilder;
+    if (useTLS) {
+        grpc::SslServerCredentialsOptions::PemKeyCertPair keycert = {
+            ReadFile("server.key"),
+            ReadFile("server.crt")
+        };
+        grpc::SslServerCredentialsOptions ssl_opts(GRPC_SSL_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_AND_VERIFY);
+        ssl_opts.pem_root_certs = ReadFile("ca.crt");
+        ssl_opts.pem_key_cert_pairs.push_back(keycert);
+        registryBuilder.AddListeningPort(registryAddress, grpc::SslServerCredentials(ssl_opts));
+    } else {
+        registryBuilder.AddListeningPort(registryAddress, grpc::InsecureServerCredentials());
+    }
+    registryBuilder.RegisterService(&registryService);
+    std::unique_ptr<grpc::Server> registry(registryBuilder.BuildAndStart());
+    if (!registry) {
+        throw runtime_error("Failed to start worker registry on " + registryAddress);
+    }
+    logMessage("Master daemon listening on " + listenAddress + ", running up to " +
+               to_string(maxJobs) + " jobs at once");
+    logMessage("Workers register on " + registryAddress +
+               (useTLS ? " (mutual TLS)" : " (insecure, this host only)"));
+    if (workerAddresses.empty() && !options.useLocal) {
+        logMessage("No workers yet; a job fails if none registers within a minute of it starting");
+    }
+    server->Wait();
+}
+
+static string jobStateName(encryption::JobState state) {
+    switch (state) {
+        case encryption::JOB_QUEUED: return "queued";
+        case encryption::JOB_RUNNING: return "running";
+        case encryption::JOB_SUCCEEDED: return "succeeded";
+        case encryption::JOB_FAILED: return "failed";
+        case encryption::JOB_CANCELLED: return "cancelled";
+        default: return "unknown";
+    }
+}
+
+static void printJobStatus(const encryption::JobStatus& status) {
+    cout << "Job " << status.job_id() << ": " << jobStateName(status.state())
+         << (status.operation() == encryption::OPERATION_ENCRYPT ? ", encrypt " : ", decrypt ")
+         << status.input_path() << " -> " << status.output_path()
+         << ", " << status.chunks_done() << "/" << status.chunks_total() << " chunks"
+         << ", queued " << status.queued_ms() << " ms, running " << status.running_ms() << " ms";
+    if (!status.error_message().empty()) {
+        cout << ", error: " << status.error_message();
+    }
+    cout << endl;
+}
+
+// Client side of the MasterControl API: job <submit|status|cancel|list> ...
+bool handleJobCommand(int argc, char* argv[]) {
+    if (argc < 3) {
+        printHelp();
+        return false;
+    }
+    string command(argv[2]);
+    string daemonAddress = DEFAULT_CONTROL_ADDRESS;
+    string priority = "normal";
+    string keyPath;
+    vector<string> positional;
+    for (int i = 3; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg == "--daemon" && i + 1 < argc) {
+            daemonAddress = argv[++i];
+        } else if (arg == "--priority" && i + 1 < argc) {
+            priority = argv[++i];
+        } else if (arg == "--key" && i + 1 < argc) {
+            keyPath = fs::absolute(argv[++i]).string();
+        } else {
+            positional.push_back(arg);
         }
-        
-        FileChunk encryptedChunk;
-        encryptedChunk.id = response.chunk_id();
-        encryptedChunk.data.assign(response.processed_data().begin(), response.processed_data().end());
-        return encryptedChunk;
     }
-    
-    FileChunk DecryptChunk(const FileChunk& chunk, const std::string& key, const std::string& iv) {
-        encryption::ChunkRequest request;
-        request.set_data(chunk.data.data(), chunk.data.size());
-        request.set_chunk_id(chunk.id);
-        request.set_key(key.data(), key.size());
-        request.set_iv(iv.data(), iv.size());
-        
-        encryption::ChunkResponse response;
-        grpc::ClientContext context;
-        
-        // Set a timeout for the operation
-        auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(10);
-        context.set_deadline(deadline);
-        
-        grpc::Status status = stub_->DecryptChunk(&context, request, &response);
-        
-        if (!status.ok() || !response.success()) {
-            std::string error = "Decryption failed on worker";
-            if (!status.ok()) {
-                error += ": gRPC error: " + status.error_message();
-            } else {
-                error += ": " + response.error_message();
+
+    auto stub = encryption::MasterControl::NewStub(
+        grpc::CreateChannel(daemonAddress, grpc::InsecureChannelCredentials()));
+    grpc::ClientContext context;
+    context.set_deadline(system_clock::now() + seconds(10));
+    grpc::Status status;
+
+    if (command == "submit" && positional.size() == 3) {
+        encryption::SubmitJobRequest request;
+        encryption::SubmitJobResponse response;
+        if (positional[0] != "encrypt" && positional[0] != "decrypt") {
+            printHelp();
+            return false;
+        }
+        request.set_operation(positional[0] == "encrypt" ? encryption::OPERATION_ENCRYPT
+                                                         : encryption::OPERATION_DECRYPT);
+        // The daemon may run in another directory
+        request.set_input_path(fs::absolute(positional[1]).string());
+        request.set_output_path(fs::absolute(positional[2]).string());
+        request.set_key_path(keyPath);
+        if (priority == "high") {
+            request.set_priority(encryption::JOB_PRIORITY_HIGH);
+        } else if (priority == "low") {
+            request.set_priority(encryption::JOB_PRIORITY_LOW);
+        } else if (priority != "normal") {
+            cerr << "Error: unknown priority: " << priority << endl;
+            return false;
+        }
+        status = stub->SubmitJob(&context, request, &response);
+        if (status.ok()) {
+            if (!response.accepted()) {
+                cerr << "Job rejected: " << response.error_message() << endl;
+                return false;
             }
-            throw std::runtime_error(error);
+            cout << "Submitted job " << response.job_id() << endl;
         }
-        
-        FileChunk decryptedChunk;
-        decryptedChunk.id = response.chunk_id();
-        decryptedChunk.data.assign(response.processed_data().begin(), response.processed_data().end());
-        return decryptedChunk;
+    } else if ((command == "status" || command == "cancel") && positional.size() == 1) {
+        uint64_t id = stoull(positional[0]);
+        if (command == "status") {
+            encryption::JobStatusRequest request;
+            encryption::JobStatus response;
+            request.set_job_id(id);
+            status = stub->GetJobStatus(&context, request, &response);
+            if (status.ok()) {
+                if (!response.found()) {
+                    cerr << "Unknown job: " << id << endl;
+                    return false;
+                }
+                printJobStatus(response);
+            }
+        } else {
+            encryption::CancelJobRequest request;
+            encryption::CancelJobResponse response;
+            request.set_job_id(id);
+            status = stub->CancelJob(&context, request, &response);
+            if (status.ok()) {
+                if (!response.success()) {
+                    cerr << "Job " << id << " is unknown or already finished" << endl;
+                    return false;
+                }
+                cout << "Cancelled job " << id << endl;
+            }
+        }
+    } else if (command == "list" && positional.empty()) {
+        encryption::ListJobsRequest request;
+        encryption::ListJobsResponse response;
+        status = stub->ListJobs(&context, request, &response);
+        if (status.ok()) {
+            for (const auto& job : response.jobs()) {
+                printJobStatus(job);
+            }
+            if (response.jobs_size() == 0) {
+                cout << "No jobs" << endl;
+            }
+        }
+    } else {
+        printHelp();
+        return false;
     }
-    
-private:
-    std::unique_ptr<encryption::EncryptionService::Stub> stub_;
-};
 
-void processFile(const vector<string>& workerAddresses, const string& inputFile, string outputFile, bool encryptMode, bool useTLS, bool uploadToDropbox = false) {
+    if (!status.ok()) {
+        cerr << "Master daemon at " << daemonAddress << " did not answer: " << status.error_message() << endl;
+        return false;
+    }
+    return true;
+}
+
+void processFile(const vector<string>& workerAddresses, const string& inputFile, string outputFile, bool encryptMode, bool useTLS, bool uploadToDropbox = false, const MasterOptions& options = MasterOptions()) {
     auto start = high_resolution_clock::now();
     
     logMessage("Processing file: " + inputFile + " -> " + outputFile);
@@ -426,13 +700,18 @@ void processFile(const vector<string>& workerAddresses, const string& inputFile,
             }
         }
         
-        logMessage("Initializing master with " + to_string(workerAddresses.size()) + " worker(s)...");
-        EncryptionMaster master(workerAddresses, useTLS);
+        if (workerAddresses.empty()) {
+            logMessage("Initializing master without workers, processing on this host only...");
+        } else {
+            logMessage("Initializing master with " + to_string(workerAddresses.size()) + " worker(s)...");
+        }
+        EncryptionMaster master(workerAddresses, useTLS, options.connectionsPerWorker);
+        configureMaster(master, options);
         
         // Test connections before processing
         logMessage("Testing connections to workers...");
-        if (!master.testWorkerConnections()) {
-            logMessage("Error: Not all workers are reachable", true);
+        if (!workerAddresses.empty() && !master.testWorkerConnections()) {
+            logMessage("Error: No workers are reachable", true);
             return;
         }
 
@@ -484,163 +763,21 @@ void processFile(const vector<string>& workerAddresses, const string& inputFile,
             logMessage("IV size: " + to_string(iv.size()) + " bytes");
         }
 
-        // Process the file
-        vector<FileChunk> processedChunks;
+        // Stream the file through the workers straight into the output file
+        bool success = false;
         try {
             if (encryptMode) {
                 logMessage("Encrypting file: " + resolvedInputPath);
-                processedChunks = master.encryptFile(resolvedInputPath, DEFAULT_CHUNK_SIZE, key, iv);
-                
-                // Directly write output file after encryption
-                logMessage("Explicitly calling writeProcessedDataToFile for encryption output");
-                bool writeSuccess = master.writeProcessedDataToFile(resolvedOutputPath, processedChunks);
-                if (!writeSuccess) {
-                    logMessage("WARNING: writeProcessedDataToFile returned false", true);
-                }
+                success = master.encryptFileTo(resolvedInputPath, resolvedOutputPath, DEFAULT_CHUNK_SIZE, key, iv);
             } else {
                 logMessage("Decrypting file: " + resolvedInputPath);
-                processedChunks = master.decryptFile(resolvedInputPath, DEFAULT_CHUNK_SIZE, key, iv);
-                
-                // Directly write output file after decryption
-                logMessage("Explicitly calling writeProcessedDataToFile for decryption output");
-                bool writeSuccess = master.writeProcessedDataToFile(resolvedOutputPath, processedChunks);
-                if (!writeSuccess) {
-                    logMessage("WARNING: writeProcessedDataToFile returned false", true);
-                }
+                success = master.decryptFileTo(resolvedInputPath, resolvedOutputPath, DEFAULT_CHUNK_SIZE, key, iv);
             }
         } catch (const exception& e) {
             logMessage("Error during file processing: " + string(e.what()), true);
             return;
         }
         
-        // Validate chunks before reassembly
-        if (processedChunks.empty()) {
-            logMessage("Error: No processed chunks returned", true);
-            return;
-        }
-        
-        logMessage("Received " + to_string(processedChunks.size()) + " processed chunks");
-        
-        // Count total bytes in chunks for validation
-        size_t totalBytes = 0;
-        for (const auto& chunk : processedChunks) {
-            totalBytes += chunk.data.size();
-            if (chunk.data.empty()) {
-                logMessage("Warning: Chunk " + to_string(chunk.id) + " is empty", true);
-            }
-        }
-        logMessage("Total bytes in processed chunks: " + to_string(totalBytes));
-        
-        // Delete any existing output file before reassembly
-        if (filesystem::exists(resolvedOutputPath)) {
-            logMessage("Removing existing output file...");
-            error_code ec;
-            filesystem::remove(resolvedOutputPath, ec);
-            if (ec) {
-                logMessage("Warning: Failed to remove existing output file: " + ec.message(), true);
-                // Try Windows API
-                std::wstring wideResolvedOutputPath = StringToWString(resolvedOutputPath);
-                if (!DeleteFileW(wideResolvedOutputPath.c_str()) && GetLastError() != ERROR_FILE_NOT_FOUND) {
-                    logMessage("Windows API also failed to delete file: " + to_string(GetLastError()), true);
-                }
-            }
-        }
-
-        // Use the new master method to write the output file
-        logMessage("Writing data to output file: " + resolvedOutputPath);
-        
-        // Make sure we're actually using the decrypted chunks for decryption
-        if (!encryptMode && !processedChunks.empty()) {
-            logMessage("Ensuring chunks are properly decrypted before writing");
-            // Process chunks through decryption workers if not already decrypted
-            if (key.empty() || iv.empty()) {
-                logMessage("WARNING: Missing encryption key or IV for decryption", true);
-            }
-            
-            // Check if chunks already contain decrypted data by looking at processedChunks
-            bool chunksAppearDecrypted = false;
-            for (const auto& chunk : processedChunks) {
-                // Simple heuristic - encrypted data is usually more random
-                // This is just a basic check and might not be foolproof
-                if (!chunk.data.empty() && chunk.data[0] != 0) {
-                    chunksAppearDecrypted = true;
-                    break;
-                }
-            }
-            
-            if (!chunksAppearDecrypted) {
-                logMessage("Chunks don't appear to be decrypted, forcing decryption process");
-                // Create chunks from the input file
-                auto encryptedChunks = FileChunker::chunkFile(resolvedInputPath, DEFAULT_CHUNK_SIZE);
-                logMessage("Split input file into " + to_string(encryptedChunks.size()) + " chunks for decryption");
-                
-                // Process each chunk with the worker
-                processedChunks.clear();
-                processedChunks.resize(encryptedChunks.size());
-                
-                for (size_t i = 0; i < encryptedChunks.size(); ++i) {
-                    size_t workerIndex = i % workerAddresses.size();
-                    string workerAddress = workerAddresses[workerIndex];
-                    logMessage("Processing chunk " + to_string(i) + " with worker at: " + workerAddress);
-                    
-                    try {
-                        EncryptionWorkerClient worker(grpc::CreateChannel(workerAddress, grpc::InsecureChannelCredentials()));
-                        auto decryptedChunk = worker.DecryptChunk(encryptedChunks[i], key, iv);
-                        processedChunks[i] = decryptedChunk;
-                        logMessage("Successfully decrypted chunk " + to_string(i) + " (" + to_string(decryptedChunk.data.size()) + " bytes)");
-                    } catch (const exception& e) {
-                        logMessage("Error decrypting chunk " + to_string(i) + ": " + string(e.what()), true);
-                        return false;
-                    }
-                }
-                logMessage("All chunks successfully decrypted, ready for reassembly");
-            } else {
-                logMessage("Chunks appear to already be decrypted, proceeding with reassembly");
-            }
-        }
-        
-        bool success = master.writeProcessedDataToFile(resolvedOutputPath, processedChunks);
-        
-        if (!success) {
-            logMessage("Failed to write output file using master component. Attempting alternate methods...", true);
-            
-            // First, try with direct file reassembly
-            logMessage("Attempting to reassemble file using FileChunker...");
-            bool reassembled = FileChunker::reassembleFile(resolvedOutputPath, processedChunks);
-            
-            if (!reassembled) {
-                logMessage("FileChunker reassembly failed. Trying direct file writing...", true);
-                
-                // Try direct file writing with ofstream
-                std::ofstream directFile(resolvedOutputPath, std::ios::binary);
-                if (directFile.is_open()) {
-                    logMessage("Successfully opened file with std::ofstream");
-                    
-                    // Sort chunks by ID before writing
-                    std::vector<FileChunk> sortedChunks = processedChunks;
-                    std::sort(sortedChunks.begin(), sortedChunks.end(), 
-                              [](const FileChunk& a, const FileChunk& b) { return a.id < b.id; });
-                    
-                    // Write the processed chunks directly
-                    size_t bytesWritten = 0;
-                    for (const auto& chunk : sortedChunks) {
-                        if (!chunk.data.empty()) {
-                            directFile.write(chunk.data.data(), chunk.data.size());
-                            bytesWritten += chunk.data.size();
-                        }
-                    }
-                    directFile.close();
-                    logMessage("Wrote " + std::to_string(bytesWritten) + " bytes directly to file");
-                    
-                    success = true;
-                } else {
-                    logMessage("Failed to create file directly with std::ofstream", true);
-                }
-            } else {
-                success = true;
-            }
-        }
-        
         if (success) {
             auto end = high_resolution_clock::now();
             auto duration = duration_cast<milliseconds>(end - start);
@@ -651,6 +788,10 @@ void processFile(const vector<string>& workerAddresses, const string& inputFile,
                 logMessage("File processed successfully: " + resolvedOutputPath + 
                            " (" + to_string(outputFileSize) + " bytes)");
                 logMessage("Time taken: " + to_string(duration.count()) + " ms");
+                if (duration.count() > 0) {
+                    double mbPerSecond = (inputFileSize / (1024.0 * 1024.0)) / (duration.count() / 1000.0);
+                    logMessage("Throughput: " + to_string(mbPerSecond) + " MB/s");
+                }
                 
                 // Test if the file can be opened for reading
                 ifstream readTest(resolvedOutputPath, ios::binary);
@@ -858,6 +999,15 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (mode == "job") {
+        try {
+            return handleJobCommand(argc, argv) ? 0 : 1;
+        } catch (const exception& e) {
+            logMessage("Error: " + string(e.what()), true);
+            return 1;
+        }
+    }
+
     try {
         if (mode == "worker" && argc >= 3) {
             string address(argv[2]);
@@ -866,15 +1016,105 @@ int main(int argc, char* argv[]) {
                 address += ":" + DEFAULT_WORKER_PORT;
                 logMessage("No port specified, using default: " + DEFAULT_WORKER_PORT);
             }
-            runWorker(address, useTLS);
+            string masterAddress;
+            string advertiseAddress;
+            string sharedRoot;
+            WorkerThreads threads;
+            for (int i = 3; i < argc; ++i) {
+                if (string(argv[i]) == "--master" && i + 1 < argc) {
+                    masterAddress = argv[++i];
+                } else if (string(argv[i]) == "--advertise" && i + 1 < argc) {
+                    advertiseAddress = argv[++i];
+                } else if (string(argv[i]) == "--shared-root" && i + 1 < argc) {
+                    sharedRoot = argv[++i];
+                } else if (string(argv[i]) == "--crypto-threads" && i + 1 < argc) {
+                    threads.cryptoThreads = stoul(argv[++i]);
+                }
+            }
+            if (!masterAddress.empty() && advertiseAddress.empty()) {
+                // A wildcard listen address is no use to the master
+                advertiseAddress = address;
+                if (advertiseAddress.rfind("0.0.0.0:", 0) == 0) {
+                    logMessage("Error: --advertise <address:port> is needed when listening on " + address, true);
+                    return 1;
+                }
+            }
+            runWorker(address, useTLS, masterAddress, advertiseAddress, sharedRoot, threads);
+        }
+        else if (mode == "local" && argc >= 5) {
+            // Single-host mode: no workers, every core runs the local pool.
+            // Also the per-node baseline to compare cluster throughput against.
+            string operation(argv[2]);
+            if (operation != "encrypt" && operation != "decrypt") {
+                printHelp();
+                return 1;
+            }
+            string inputFile(argv[3]);
+            string outputFile(argv[4]);
+
+            MasterOptions options;
+            options.useLocal = true;
+            for (int i = 5; i < argc; ++i) {
+                if (string(argv[i]) == "--memory-budget" && i + 1 < argc) {
+                    options.memoryBudget = stoull(argv[++i]) * 1024 * 1024;
+                    logMessage("Memory budget: " + string(argv[i]) + " MB");
+                    continue;
+                }
+                if (string(argv[i]) == "--threads" && i + 1 < argc) {
+                    options.localThreads = static_cast<size_t>(stoul(argv[++i]));
+                    logMessage("Local crypto threads: " + to_string(options.localThreads));
+                    continue;
+                }
+                if (string(argv[i]) == "--cipher" && i + 1 < argc) {
+                    options.cipherMode = AESCrypto::parseCipherMode(argv[++i]);
+                    logMessage("Cipher: " + AESCrypto::cipherModeName(options.cipherMode));
+                    continue;
+                }
+                logMessage("Ignoring unknown option for local mode: " + string(argv[i]), true);
+            }
+
+            logMessage("Mode: local " + operation + ", Input: " + inputFile + ", Output: " + outputFile);
+            processFile(vector<string>(), inputFile, outputFile, operation == "encrypt", false, false, options);
+        }
+        else if (mode == "master-daemon") {
+            vector<string> workerAddresses;
+            MasterOptions options;
+            string listenAddress = DEFAULT_CONTROL_ADDRESS;
+            string registryAddress = DEFAULT_REGISTRY_ADDRESS;
+            size_t maxJobs = 4;
+            for (int i = 2; i < argc; ++i) {
+                if (string(argv[i]) == "--tls") continue;
+                if (parseMasterOption(argc, argv, i, options)) continue;
+                if (string(argv[i]) == "--listen" && i + 1 < argc) {
+                    listenAddress = argv[++i];
+                    continue;
+                }
+                if (string(argv[i]) == "--registry" && i + 1 < argc) {
+                    registryAddress = argv[++i];
+                    continue;
+                }
+                if (string(argv[i]) == "--jobs" && i + 1 < argc) {
+                    maxJobs = static_cast<size_t>(stoul(argv[++i]));
+                    continue;
+                }
+                string address(argv[i]);
+                if (address.find(':') == string::npos) {
+                    address += ":" + DEFAULT_WORKER_PORT;
+                    logMessage("No port specified for worker, using default: " + address);
+                }
+                workerAddresses.push_back(address);
+            }
+            runMasterDaemon(workerAddresses, useTLS, options, listenAddress, registryAddress, maxJobs);
         }
         else if ((mode == "master" || mode == "encrypt" || mode == "decrypt") && argc >= 5) {
             string inputFile(argv[2]);
             string outputFile(argv[3]);
             vector<string> workerAddresses;
             
+            MasterOptions options;
             for (int i = 4; i < argc; ++i) {
-                if (string(argv[i]) == "--tls") continue;
+                if (string(argv[i]) == "--tls" || string(argv[i]) == "--dropbox") continue;
+                if (parseMasterOption(argc, argv, i, options)) continue;
                 string address(argv[i]);
                 // Add default port if not specified
                 if (address.find(':') == string::npos) {
@@ -904,7 +1144,7 @@ int main(int argc, char* argv[]) {
                 }
             }
             
-            processFile(workerAddresses, inputFile, outputFile, encryptMode, useTLS, uploadToDropbox);
+            processFile(workerAddresses, inputFile, outputFile, encryptMode, useTLS, uploadToDropbox, options);
         }
         else {
             printHelp();
@@ -0,0 +1,57 @@
+#include "arena.h"
+#include <iomanip>
+#include <sstream>
+
+void ArenaStats::reset() {
+    arenas = 0;
+    messages = 0;
+    bytesUsed = 0;
+    heapBytes = 0;
+}
+
+std::string ArenaStats::summary(uint64_t count) const {
+    std::ostringstream out;
+    if (count == 0) {
+        return out.str();
+    }
+    double perUnit = 1.0 / static_cast<double>(count);
+    out << "Protobuf arenas: " << std::fixed << std::setprecision(2)
+        << messages.load() * perUnit << " messages and "
+        << arenas.load() * perUnit << " arenas, "
+        << bytesUsed.load() / count << " bytes used and "
+        << heapBytes.load() / count << " heap bytes each" << std::endl;
+    return out.str();
+}
+
+static google::protobuf::ArenaOptions inlineBlock(char* block, size_t size) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block;
+    options.initial_block_size = size;
+    return options;
+}
+
+CallArena::CallArena(ArenaStats* stats)
+    : stats_(stats),
+      arena_(inlineBlock(block_, kInlineBlockSize)) {
+}
+
+CallArena::~CallArena() {
+    record();
+}
+
+void CallArena::reset() {
+    record();
+    arena_.Reset();
+    messages_ = 0;
+}
+
+void CallArena::record() {
+    if (!stats_ || messages_ == 0) {
+        return;
+    }
+    uint64_t allocated = arena_.SpaceAllocated();
+    ++stats_->arenas;
+    stats_->messages += messages_;
+    stats_->bytesUsed += arena_.SpaceUsed();
+    stats_->heapBytes += allocated > kInlineBlockSize ? allocated - kInlineBlockSize : 0;
+}
@@ -0,0 +1,93 @@
+#include "channel_registry.h"
+#include "utilities.h"
+#include <iostream>
+
+ChannelPool::Lease::Lease(std::shared_ptr<WorkerChannel> channel, size_t index)
+    : channel_(std::move(channel)), index_(index) {
+}
+
+ChannelPool::Lease::Lease(Lease&& other) noexcept
+    : channel_(std::move(other.channel_)), index_(other.index_) {
+}
+
+ChannelPool::Lease& ChannelPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        channel_ = std::move(other.channel_);
+        index_ = other.index_;
+    }
+    return *this;
+}
+
+ChannelPool::Lease::~Lease() {
+    release();
+}
+
+void ChannelPool::Lease::release() {
+    if (channel_) {
+        --channel_->outstanding;
+        channel_.reset();
+    }
+}
+
+ChannelPool::ChannelPool(std::string address, std::vector<std::shared_ptr<WorkerChannel>> channels)
+    : address_(std::move(address)), channels_(std::move(channels)) {
+}
+
+ChannelPool::Lease ChannelPool::lease() {
+    // Racing leases may both pick the same connection; the counts even out
+    size_t best = 0;
+    for (size_t i = 1; i < channels_.size(); ++i) {
+        if (channels_[i]->outstanding.load() < channels_[best]->outstanding.load()) {
+            best = i;
+        }
+    }
+    ++channels_[best]->outstanding;
+    return Lease(channels_[best], best);
+}
+
+ChannelRegistry& ChannelRegistry::instance() {
+    static ChannelRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<ChannelPool> ChannelRegistry::pool(const std::string& address, bool useTLS, size_t connections) {
+    connections = std::max<size_t>(1, connections);
+    std::vector<std::shared_ptr<WorkerChannel>> channels;
+    channels.reserve(connections);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < connections; ++i) {
+        auto& entry = channels_[Key(address, useTLS, i)];
+        if (!entry) {
+            std::cout << "Creating channel " << i << " to worker at " << address
+                      << (useTLS ? " (TLS)" : " (insecure)") << std::endl;
+            entry = std::make_shared<WorkerChannel>();
+            entry->channel = createChannel(address, useTLS, i);
+            entry->stub = encryption::EncryptionService::NewStub(entry->channel);
+            entry->generic = std::make_unique<grpc::GenericStub>(entry->channel);
+        }
+        channels.push_back(entry);
+    }
+    return std::make_shared<ChannelPool>(address, std::move(channels));
+}
+
+std::shared_ptr<grpc::Channel> ChannelRegistry::createChannel(const std::string& address, bool useTLS, size_t index) {
+    // Channels with identical arguments share one connection through the global
+    // subchannel pool; a local pool and a distinct argument keep them apart
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    args.SetInt("encryption.connection_index", static_cast<int>(index));
+
+    if (useTLS) {
+        grpc::SslCredentialsOptions ssl_opts;
+        try {
+            ssl_opts.pem_root_certs = ReadFile("ca.crt");
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load TLS credentials: " << e.what() << std::endl;
+            throw;
+        }
+        return grpc::CreateCustomChannel(address, grpc::SslCredentials(ssl_opts), args);
+    }
+    return grpc::CreateCustomChannel(address, grpc::InsecureChannelCredentials(), args);
+}
@@ -1,5 +1,6 @@
 #include "chunk.h"
 #include "utilities.h"
+#include "writer.h"
 #include <fstream>
 #include <iostream>
 #include <system_error>
@@ -8,6 +9,79 @@
 #include <string.h>  // For strerror
 #include <filesystem> // For std::filesystem
 #include <windows.h> // For Windows API file operations
+#include <algorithm>
+#include <stdexcept>
+
+size_t FileChunker::effectiveChunkSize(size_t chunkSize) {
+    // Use a smaller chunk size to avoid boundary issues with AES blocks
+    // AES operates on 16-byte blocks, so we want to avoid issues at block boundaries
+    size_t safeChunkSize = chunkSize;
+    if (safeChunkSize % 16 == 0) {
+        safeChunkSize -= 16; // Ensure we're not exactly at a block boundary
+    }
+    return safeChunkSize;
+}
+
+ChunkReader::ChunkReader(const std::string& filePath, size_t chunkSize)
+    : file_(filePath, std::ios::binary | std::ios::ate),
+      chunkSize_(chunkSize) {
+    if (!file_.is_open()) {
+        std::error_code ec(errno, std::system_category());
+        std::cerr << "Failed to open file: " << filePath 
+                  << ", error: " << ec.value() << " - " << ec.message() << std::endl;
+        throw std::runtime_error("Failed to open file: " + filePath);
+    }
+    if (chunkSize_ == 0) {
+        throw std::runtime_error("Chunk size must be greater than zero");
+    }
+    
+    fileSize_ = static_cast<uint64_t>(file_.tellg());
+    file_.seekg(0, std::ios::beg);
+}
+
+size_t ChunkReader::chunkCount() const {
+    return static_cast<size_t>((fileSize_ + chunkSize_ - 1) / chunkSize_);
+}
+
+bool ChunkReader::next(FileChunk& chunk) {
+    if (offset_ >= fileSize_) {
+        return false;
+    }
+    
+    size_t toRead = static_cast<size_t>(std::min<uint64_t>(chunkSize_, fileSize_ - offset_));
+    chunk.data.resize(toRead);
+    file_.read(chunk.data.data(), toRead);
+    std::streamsize bytesRead = file_.gcount();
+    if (bytesRead <= 0) {
+        return false;
+    }
+    
+    chunk.data.resize(static_cast<size_t>(bytesRead));
+    chunk.id = nextId_++;
+    chunk.offset = offset_;
+    offset_ += static_cast<uint64_t>(bytesRead);
+    return true;
+}
+
+bool ChunkReader::readRange(uint64_t offset, size_t size, FileChunk& chunk) {
+    if (offset + size > fileSize_) {
+        throw std::runtime_error("Chunk range " + std::to_string(offset) + "+" + std::to_string(size) +
+                                 " lies beyond the end of the file");
+    }
+    
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    chunk.data.resize(size);
+    file_.read(chunk.data.data(), size);
+    if (file_.gcount() != static_cast<std::streamsize>(size)) {
+        throw std::runtime_error("Short read of " + std::to_string(size) + " bytes at offset " + std::to_string(offset));
+    }
+    
+    chunk.id = nextId_++;
+    chunk.offset = offset;
+    offset_ = offset + size;
+    return true;
+}
 
 std::vector<FileChunk> FileChunker::chunkFile(const std::string& filePath, size_t chunkSize) {
     std::cout << "Opening file for chunking: " << filePath << std::endl;
@@ -22,43 +96,20 @@ std::vector<FileChunk> FileChunker::chunkFile(const std::string& filePath, size_
     std::string resolvedPath(absolutePath);
     std::cout << "Resolved absolute path: " << resolvedPath << std::endl;
     
-    std::ifstream file(resolvedPath, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        std::error_code ec(errno, std::system_category());
-        std::cerr << "Failed to open file: " << resolvedPath 
-                  << ", error: " << ec.value() << " - " << ec.message() << std::endl;
-        throw std::runtime_error("Failed to open file: " + resolvedPath);
-    }
-
-    std::streamsize fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+    size_t safeChunkSize = effectiveChunkSize(chunkSize);
+    ChunkReader reader(resolvedPath, safeChunkSize);
     
-    std::cout << "File size: " << fileSize << " bytes" << std::endl;
+    std::cout << "File size: " << reader.fileSize() << " bytes" << std::endl;
+    std::cout << "Using chunk size: " << safeChunkSize << " bytes" << std::endl;
 
     std::vector<FileChunk> chunks;
-    int chunkId = 0;
+    chunks.reserve(reader.chunkCount());
     
-    // Use a smaller chunk size to avoid boundary issues with AES blocks
-    // AES operates on 16-byte blocks, so we want to avoid issues at block boundaries
-    size_t safeChunkSize = chunkSize;
-    if (safeChunkSize % 16 == 0) {
-        safeChunkSize -= 16; // Ensure we're not exactly at a block boundary
-    }
-    
-    std::cout << "Using chunk size: " << safeChunkSize << " bytes" << std::endl;
-    std::vector<char> buffer(safeChunkSize);
-
-    while (file) {
-        file.read(buffer.data(), buffer.size());
-        std::streamsize bytesRead = file.gcount();
-        
-        if (bytesRead > 0) {
-            FileChunk chunk;
-            chunk.data.assign(buffer.begin(), buffer.begin() + bytesRead);
-            chunk.id = chunkId++;
-            chunks.push_back(chunk);
-            std::cout << "Created chunk " << chunk.id << " with " << bytesRead << " bytes" << std::endl;
-        }
+    FileChunk chunk;
+    while (reader.next(chunk)) {
+        std::cout << "Created chunk " << chunk.id << " with " << chunk.data.size() << " bytes" << std::endl;
+        chunks.push_back(std::move(chunk));
+        chunk = FileChunk();
     }
 
     std::cout << "Created " << chunks.size() << " chunks from file" << std::endl;
@@ -99,274 +150,21 @@ bool createDirectoryRecursive(const std::string& dirPath) {
     return true;
 }
 
-// Helper function to write file using Windows API
-bool writeFileWithWindowsAPI(const std::string& filePath, const std::vector<FileChunk>& chunks) {
-    std::cout << "Attempting to write file using Windows API: " << filePath << std::endl;
-    std::cout << "File path length: " << filePath.length() << " characters" << std::endl;
-    
-    // Check if path contains long path prefix
-    bool hasLongPathPrefix = (filePath.substr(0, 4) == "\\\\?\\");
-    std::string actualPath = filePath;
-    
-    // Convert path to wide string for Windows API
-    std::wstring wideFilePath = StringToWString(filePath);
-    std::cout << "Wide path length: " << wideFilePath.length() << " characters" << std::endl;
-    
-    // Try to add long path prefix if the path is long
-    if (!hasLongPathPrefix && wideFilePath.length() > MAX_PATH - 12) { // Leave room for filename
-        std::cout << "Path is long, adding \\\\?\\ prefix" << std::endl;
-        if (filePath.substr(0, 2) == "\\\\") {
-            // UNC path - use \\?\UNC\server\share format
-            actualPath = "\\\\?\\UNC\\" + filePath.substr(2);
-        } else {
-            // Local path
-            actualPath = "\\\\?\\" + filePath;
-        }
-        wideFilePath = StringToWString(actualPath);
-        std::cout << "Modified path with prefix: " << actualPath << std::endl;
-    }
-    
-    // Show detailed file path information
-    std::cout << "Absolute Path: " << filePath << std::endl;
-    std::string directory = filePath.substr(0, filePath.find_last_of("/\\"));
-    std::cout << "Directory: " << directory << std::endl;
-    std::string filename = filePath.substr(filePath.find_last_of("/\\") + 1);
-    std::cout << "Filename: " << filename << std::endl;
-    
-    // Verify parent directory exists
-    std::wstring wideDirectory = StringToWString(directory);
-    DWORD dirAttrs = GetFileAttributesW(wideDirectory.c_str());
-    if (dirAttrs == INVALID_FILE_ATTRIBUTES) {
-        std::cout << "ERROR: Parent directory does not exist or cannot be accessed: " << directory << std::endl;
-        std::cout << "GetFileAttributesW error: " << GetLastError() << std::endl;
-        
-        // Try to create the directory
-        if (!CreateDirectoryW(wideDirectory.c_str(), NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
-            std::cout << "ERROR: Failed to create parent directory: " << GetLastError() << std::endl;
-            return false;
-        } else {
-            std::cout << "Created parent directory" << std::endl;
-        }
-    } else {
-        std::cout << "Parent directory exists" << std::endl;
-    }
-    
-    // Create or open file with explicit security attributes and flags
-    SECURITY_ATTRIBUTES sa = { sizeof(SECURITY_ATTRIBUTES), NULL, FALSE };
-    
-    std::cout << "Creating file with CreateFileW..." << std::endl;
-    HANDLE hFile = CreateFileW(
-        wideFilePath.c_str(),
-        GENERIC_WRITE,
-        0,                      // No sharing
-        &sa,                    // Explicit security attributes
-        CREATE_ALWAYS,          // Always create
-        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_WRITE_THROUGH,  // Normal file with write-through
-        NULL                    // No template
-    );
-    
-    if (hFile == INVALID_HANDLE_VALUE) {
-        DWORD error = GetLastError();
-        std::cerr << "Windows API CreateFile failed: " << filePath 
-                  << ", Error code: " << error << std::endl;
-        
-        // Print error description
-        LPVOID errorMsg;
-        FormatMessageW(
-            FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM,
-            NULL,
-            error,
-            0,
-            (LPWSTR)&errorMsg,
-            0,
-            NULL
-        );
-        
-        if (errorMsg) {
-            std::wcerr << L"Error message: " << (LPWSTR)errorMsg << std::endl;
-            LocalFree(errorMsg);
-        }
-        
-        // Attempt an alternate approach
-        std::cout << "Attempting creation with alternate file API..." << std::endl;
-        std::ofstream testFile(filePath.c_str(), std::ios::binary | std::ios::out);
-        if (testFile.is_open()) {
-            std::cout << "Successfully opened file with std::ofstream" << std::endl;
-            testFile.close();
-            
-            // Now try again with Windows API
-            hFile = CreateFileW(
-                wideFilePath.c_str(),
-                GENERIC_WRITE,
-                0,
-                NULL,
-                OPEN_EXISTING,  // Open existing since we just created it
-                FILE_ATTRIBUTE_NORMAL,
-                NULL
-            );
-            
-            if (hFile == INVALID_HANDLE_VALUE) {
-                error = GetLastError();
-                std::cerr << "Windows API CreateFile still failed on second attempt: " 
-                          << ", Error code: " << error << std::endl;
-                return false;
-            }
-            
-            std::cout << "Successfully opened file on second attempt" << std::endl;
-        } else {
-            std::cerr << "Both Windows API and std::ofstream failed to create file" << std::endl;
+// Helper function to write every chunk at its final offset
+static bool writeChunksPositional(const std::string& filePath, const std::vector<FileChunk>& chunks) {
+    try {
+        PositionalFileWriter writer(filePath, chunks.size());
+        writer.writeChunks(chunks);
+        uint64_t totalBytesWritten = writer.bytesWritten();
+        if (!writer.close()) {
             return false;
         }
-    }
-    
-    size_t totalBytesWritten = 0;
-    bool success = true;
-    
-    std::cout << "File handle obtained successfully, beginning to write " << chunks.size() << " chunks" << std::endl;
-    
-    // Verify file handle is valid again
-    DWORD fileType = GetFileType(hFile);
-    if (fileType == FILE_TYPE_UNKNOWN) {
-        std::cerr << "WARNING: File handle has unknown type: " << GetLastError() << std::endl;
-    } else {
-        std::cout << "File handle verified as valid, type: " << fileType << std::endl;
-    }
-    
-    for (const auto& chunk : chunks) {
-        if (chunk.data.empty()) {
-            std::cerr << "Warning: Chunk " << chunk.id << " is empty, skipping" << std::endl;
-            continue;
-        }
-        
-        std::cout << "Writing chunk " << chunk.id << " (" << chunk.data.size() << " bytes)" << std::endl;
-        
-        DWORD bytesWritten = 0;
-        if (!WriteFile(
-            hFile,
-            chunk.data.data(),
-            static_cast<DWORD>(chunk.data.size()),
-            &bytesWritten,
-            NULL
-        )) {
-            DWORD error = GetLastError();
-            std::cerr << "Windows API WriteFile failed for chunk " << chunk.id 
-                      << ", Error code: " << error << std::endl;
-            
-            // Print error description
-            LPVOID errorMsg;
-            FormatMessageW(
-                FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM,
-                NULL,
-                error,
-                0,
-                (LPWSTR)&errorMsg,
-                0,
-                NULL
-            );
-            
-            if (errorMsg) {
-                std::wcerr << L"Error message: " << (LPWSTR)errorMsg << std::endl;
-                LocalFree(errorMsg);
-            }
-            
-            success = false;
-            break;
-        }
-        
-        if (bytesWritten != chunk.data.size()) {
-            std::cerr << "Windows API WriteFile: Partial write for chunk " << chunk.id 
-                      << ", wrote " << bytesWritten << " of " << chunk.data.size() << " bytes" << std::endl;
-            success = false;
-            break;
-        }
-        
-        totalBytesWritten += bytesWritten;
-        std::cout << "Successfully wrote chunk " << chunk.id << " (" << bytesWritten << " bytes)" << std::endl;
-    }
-    
-    if (success) {
         std::cout << "All chunks written successfully, total bytes: " << totalBytesWritten << std::endl;
-    } else {
-        std::cerr << "Failed to write all chunks, stopping at " << totalBytesWritten << " bytes" << std::endl;
-    }
-    
-    std::cout << "Flushing file buffers..." << std::endl;
-    // Flush file buffers to ensure data is written to disk
-    if (!FlushFileBuffers(hFile)) {
-        DWORD error = GetLastError();
-        std::cerr << "Windows API FlushFileBuffers failed: Error code: " << error << std::endl;
-        
-        // Print error description
-        LPVOID errorMsg;
-        FormatMessageW(
-            FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM,
-            NULL,
-            error,
-            0,
-            (LPWSTR)&errorMsg,
-            0,
-            NULL
-        );
-        
-        if (errorMsg) {
-            std::wcerr << L"Error message: " << (LPWSTR)errorMsg << std::endl;
-            LocalFree(errorMsg);
-        }
-        
-        success = false;
-    } else {
-        std::cout << "File buffers flushed successfully" << std::endl;
-    }
-    
-    std::cout << "Closing file handle..." << std::endl;
-    if (!CloseHandle(hFile)) {
-        DWORD error = GetLastError();
-        std::cerr << "Windows API CloseHandle failed: Error code: " << error << std::endl;
-        
-        // Print error description
-        LPVOID errorMsg;
-        FormatMessageW(
-            FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM,
-            NULL,
-            error,
-            0,
-            (LPWSTR)&errorMsg,
-            0,
-            NULL
-        );
-        
-        if (errorMsg) {
-            std::wcerr << L"Error message: " << (LPWSTR)errorMsg << std::endl;
-            LocalFree(errorMsg);
-        }
-        
-        success = false;
-    } else {
-        std::cout << "File handle closed successfully" << std::endl;
-    }
-    
-    // Verify the file exists and is the correct size after closing
-    if (success) {
-        std::cout << "Verifying file exists after writing..." << std::endl;
-        WIN32_FILE_ATTRIBUTE_DATA fileInfo;
-        if (GetFileAttributesExW(wideFilePath.c_str(), GetFileExInfoStandard, &fileInfo)) {
-            ULARGE_INTEGER fileSize;
-            fileSize.LowPart = fileInfo.nFileSizeLow;
-            fileSize.HighPart = fileInfo.nFileSizeHigh;
-            std::cout << "File verified: " << filePath << ", size: " << fileSize.QuadPart << " bytes" << std::endl;
-            
-            if (fileSize.QuadPart != totalBytesWritten) {
-                std::cerr << "WARNING: File size mismatch. Written: " << totalBytesWritten 
-                          << ", Actual: " << fileSize.QuadPart << std::endl;
-            }
-        } else {
-            DWORD error = GetLastError();
-            std::cerr << "ERROR: Failed to verify file after writing: " << error << std::endl;
-            success = false;
-        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Positional write failed: " << e.what() << std::endl;
+        return false;
     }
-    
-    return success;
 }
 
 bool FileChunker::reassembleFile(const std::string& outputPath, const std::vector<FileChunk>& chunks) {
@@ -497,10 +295,10 @@ bool FileChunker::reassembleFile(const std::string& outputPath, const std::vecto
         }
     }
     
-    // Try Windows API directly for file creation - most reliable approach
-    std::cout << "Attempting direct Windows API file creation..." << std::endl;
-    if (writeFileWithWindowsAPI(resolvedPath, chunks)) {
-        std::cout << "Successfully wrote file using Windows API" << std::endl;
+    // Write each chunk straight to its offset - no copy or sort of the chunk data
+    std::cout << "Attempting positional file write..." << std::endl;
+    if (writeChunksPositional(resolvedPath, chunks)) {
+        std::cout << "Successfully wrote file using positional writer" << std::endl;
         
         // Final verification before returning
         bool finalCheck = false;
@@ -0,0 +1,229 @@
+#include "container.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const char kHeaderMagic[8] = {'D', 'D', 'E', 'N', 'C', 'R', 'Y', 'P'};
+const char kFooterMagic[8] = {'D', 'D', 'E', 'N', 'C', 'E', 'N', 'D'};
+
+void putLE(std::vector<char>& out, size_t pos, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[pos + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+uint64_t getLE(const char* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+void readExact(std::ifstream& file, uint64_t offset, char* buffer, size_t size, const std::string& what) {
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    file.read(buffer, size);
+    if (file.gcount() != static_cast<std::streamsize>(size)) {
+        throw std::runtime_error("Truncated encrypted file: could not read " + what);
+    }
+}
+
+} // namespace
+
+ContainerLayout ContainerLayout::plan(CipherMode cipher, uint32_t chunkSize, uint64_t originalLength) {
+    if (chunkSize == 0) {
+        throw std::runtime_error("Chunk size must be greater than zero");
+    }
+
+    ContainerLayout layout;
+    ContainerHeader& header = layout.header_;
+    header.version = kVersion;
+    header.cipher = cipher;
+    header.chunkSize = chunkSize;
+    header.chunkCount = (originalLength + chunkSize - 1) / chunkSize;
+    header.originalLength = originalLength;
+    header.indexOffset = kHeaderSize;
+    header.dataOffset = kHeaderSize + header.chunkCount * kIndexEntrySize;
+
+    layout.entries_.resize(static_cast<size_t>(header.chunkCount));
+    uint64_t offset = header.dataOffset;
+    for (size_t i = 0; i < layout.entries_.size(); ++i) {
+        uint64_t remaining = originalLength - static_cast<uint64_t>(i) * chunkSize;
+        ContainerIndexEntry& entry = layout.entries_[i];
+        entry.plainLength = static_cast<uint32_t>(std::min<uint64_t>(chunkSize, remaining));
+        entry.cipherLength = static_cast<uint32_t>(AESCrypto::encryptedSize(entry.plainLength, cipher));
+        entry.cipherOffset = offset;
+        offset += entry.cipherLength;
+    }
+    return layout;
+}
+
+ContainerLayout ContainerLayout::legacy(uint64_t fileSize, uint32_t plainChunkSize) {
+    ContainerLayout layout;
+    ContainerHeader& header = layout.header_;
+    header.version = 0;
+    header.cipher = CipherMode::AES_256_CBC;
+    header.chunkSize = plainChunkSize;
+
+    uint64_t cipherChunkSize = AESCrypto::encryptedSize(plainChunkSize);
+    header.chunkCount = (fileSize + cipherChunkSize - 1) / cipherChunkSize;
+
+    layout.entries_.resize(static_cast<size_t>(header.chunkCount));
+    for (size_t i = 0; i < layout.entries_.size(); ++i) {
+        ContainerIndexEntry& entry = layout.entries_[i];
+        entry.cipherOffset = static_cast<uint64_t>(i) * cipherChunkSize;
+        entry.cipherLength = static_cast<uint32_t>(std::min<uint64_t>(cipherChunkSize, fileSize - entry.cipherOffset));
+        entry.plainLength = plainChunkSize;
+    }
+    return layout;
+}
+
+bool ContainerLayout::isContainer(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kHeaderMagic)];
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) && std::memcmp(magic, kHeaderMagic, sizeof(magic)) == 0;
+}
+
+ContainerLayout ContainerLayout::read(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open encrypted file: " + path);
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+
+    std::vector<char> raw(kHeaderSize);
+    readExact(file, 0, raw.data(), raw.size(), "header");
+    if (std::memcmp(raw.data(), kHeaderMagic, sizeof(kHeaderMagic)) != 0) {
+        throw std::runtime_error("Not an encrypted container: " + path);
+    }
+
+    ContainerLayout layout;
+    ContainerHeader& header = layout.header_;
+    header.version = static_cast<uint16_t>(getLE(&raw[8], 2));
+    header.cipher = static_cast<CipherMode>(getLE(&raw[10], 2));
+    uint32_t headerSize = static_cast<uint32_t>(getLE(&raw[12], 4));
+    header.chunkSize = static_cast<uint32_t>(getLE(&raw[16], 4));
+    header.chunkCount = getLE(&raw[24], 8);
+    header.originalLength = getLE(&raw[32], 8);
+    header.indexOffset = getLE(&raw[40], 8);
+    header.dataOffset = getLE(&raw[48], 8);
+    uint8_t paramsLength = static_cast<uint8_t>(raw[20]);
+    if (paramsLength > kMaxCipherParams) {
+        throw std::runtime_error("Invalid cipher parameter length in container header");
+    }
+    header.cipherParams.assign(&raw[kHeaderSize - kMaxCipherParams], paramsLength);
+
+    if (header.version == 0 || header.version > kVersion) {
+        throw std::runtime_error("Unsupported container version " + std::to_string(header.version));
+    }
+    if (header.cipher != CipherMode::AES_256_CBC && header.cipher != CipherMode::AES_256_GCM) {
+        throw std::runtime_error("Unsupported cipher " + std::to_string(static_cast<int>(header.cipher)) + " in " + path);
+    }
+    // Bound the chunk count by what the file could hold before sizing the
+    // index from it, so a corrupt count cannot overflow or exhaust memory
+    if (fileSize < kHeaderSize + kFooterSize ||
+        header.chunkCount > (fileSize - kHeaderSize - kFooterSize) / kIndexEntrySize) {
+        throw std::runtime_error("Corrupt container header in " + path);
+    }
+    if (headerSize != kHeaderSize || header.chunkSize == 0 ||
+        header.chunkCount != (header.originalLength + header.chunkSize - 1) / header.chunkSize ||
+        header.indexOffset < kHeaderSize || header.indexOffset > fileSize ||
+        header.dataOffset != header.indexOffset + header.chunkCount * kIndexEntrySize ||
+        header.dataOffset > fileSize) {
+        throw std::runtime_error("Corrupt container header in " + path);
+    }
+
+    raw.resize(static_cast<size_t>(header.chunkCount * kIndexEntrySize));
+    readExact(file, header.indexOffset, raw.data(), raw.size(), "chunk index");
+
+    layout.entries_.resize(static_cast<size_t>(header.chunkCount));
+    uint64_t expectedOffset = header.dataOffset;
+    for (size_t i = 0; i < layout.entries_.size(); ++i) {
+        const char* p = &raw[i * kIndexEntrySize];
+        ContainerIndexEntry& entry = layout.entries_[i];
+        entry.cipherOffset = getLE(p, 8);
+        entry.cipherLength = static_cast<uint32_t>(getLE(p + 8, 4));
+        entry.plainLength = static_cast<uint32_t>(getLE(p + 12, 4));
+        if (entry.cipherOffset != expectedOffset || entry.plainLength > header.chunkSize ||
+            entry.cipherLength != AESCrypto::encryptedSize(entry.plainLength, header.cipher)) {
+            throw std::runtime_error("Corrupt index entry for chunk " + std::to_string(i) + " in " + path);
+        }
+        expectedOffset += entry.cipherLength;
+    }
+
+    if (layout.totalSize() != fileSize) {
+        throw std::runtime_error("Encrypted file size mismatch in " + path + ": expected " +
+                                 std::to_string(layout.totalSize()) + " bytes, found " + std::to_string(fileSize));
+    }
+
+    char footer[kFooterSize];
+    readExact(file, layout.footerOffset(), footer, sizeof(footer), "footer");
+    if (std::memcmp(footer, kFooterMagic, sizeof(kFooterMagic)) != 0 ||
+        getLE(footer + 8, 8) != header.chunkCount) {
+        throw std::runtime_error("Missing or corrupt container footer in " + path);
+    }
+
+    return layout;
+}
+
+uint64_t ContainerLayout::footerOffset() const {
+    if (entries_.empty()) {
+        return header_.dataOffset;
+    }
+    const ContainerIndexEntry& last = entries_.back();
+    return last.cipherOffset + last.cipherLength;
+}
+
+std::string ContainerLayout::chunkIV(const std::string& iv) const {
+    if (header_.cipher != CipherMode::AES_256_GCM) {
+        return iv;
+    }
+    std::string chunkIV = header_.cipherParams;
+    if (header_.version >= 2) {
+        std::vector<char> header = serializeHeader();
+        chunkIV.append(header.data(), header.size());
+    }
+    return chunkIV;
+}
+
+std::vector<char> ContainerLayout::serializeHeader() const {
+    std::vector<char> out(kHeaderSize, 0);
+    std::memcpy(out.data(), kHeaderMagic, sizeof(kHeaderMagic));
+    putLE(out, 8, header_.version, 2);
+    putLE(out, 10, static_cast<uint16_t>(header_.cipher), 2);
+    putLE(out, 12, kHeaderSize, 4);
+    putLE(out, 16, header_.chunkSize, 4);
+    putLE(out, 20, header_.cipherParams.size(), 1);
+    putLE(out, 24, header_.chunkCount, 8);
+    putLE(out, 32, header_.originalLength, 8);
+    putLE(out, 40, header_.indexOffset, 8);
+    putLE(out, 48, header_.dataOffset, 8);
+    if (header_.cipherParams.size() > kMaxCipherParams) {
+        throw std::runtime_error("Cipher parameters do not fit in the container header");
+    }
+    std::memcpy(&out[kHeaderSize - kMaxCipherParams], header_.cipherParams.data(), header_.cipherParams.size());
+    return out;
+}
+
+std::vector<char> ContainerLayout::serializeHeaderAndIndex() const {
+    std::vector<char> out = serializeHeader();
+    out.resize(kHeaderSize + entries_.size() * kIndexEntrySize, 0);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        size_t pos = kHeaderSize + i * kIndexEntrySize;
+        putLE(out, pos, entries_[i].cipherOffset, 8);
+        putLE(out, pos + 8, entries_[i].cipherLength, 4);
+        putLE(out, pos + 12, entries_[i].plainLength, 4);
+    }
+    return out;
+}
+
+std::vector<char> ContainerLayout::serializeFooter() const {
+    std::vector<char> out(kFooterSize, 0);
+    std::memcpy(out.data(), kFooterMagic, sizeof(kFooterMagic));
+    putLE(out, 8, header_.chunkCount, 8);
+    return out;
+}
@@ -1,10 +1,20 @@
 #include "crypto.h"
+#include <openssl/evp.h>
 #include <openssl/rand.h>
 #include <openssl/err.h>
+#include <openssl/crypto.h>
+#include <cstring>
+#include <list>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
 
 // Helper function to get OpenSSL error details
 std::string getOpenSSLErrors() {
@@ -20,112 +30,354 @@ std::string getOpenSSLErrors() {
     return oss.str();
 }
 
-std::vector<unsigned char> AESCrypto::encrypt(const std::vector<char>& data, 
-                                             const std::string& key, 
-                                             const std::string& iv) {
-    // Check key and IV size
+namespace {
+const size_t kGcmNonceSize = 12;
+const size_t kGcmTagSize = 16;
+const size_t kContextCacheSize = 8;
+
+const EVP_CIPHER* cipherFor(CipherMode mode) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    // Explicit fetches skip the per-init provider lookup that the
+    // EVP_aes_256_*() shims do under OpenSSL 3; fetched once per process
+    static EVP_CIPHER* cbc = EVP_CIPHER_fetch(NULL, "AES-256-CBC", NULL);
+    static EVP_CIPHER* gcm = EVP_CIPHER_fetch(NULL, "AES-256-GCM", NULL);
+    const EVP_CIPHER* cipher = mode == CipherMode::AES_256_GCM ? gcm : cbc;
+#else
+    const EVP_CIPHER* cipher = mode == CipherMode::AES_256_GCM ? EVP_aes_256_gcm() : EVP_aes_256_cbc();
+#endif
+    if (!cipher) {
+        throw std::runtime_error("Cipher " + AESCrypto::cipherModeName(mode) + " is not available: " + getOpenSSLErrors());
+    }
+    return cipher;
+}
+}
+
+CipherContext::CipherContext(CipherMode mode, CipherDirection direction, const std::string& key)
+    : mode_(mode), direction_(direction), key_(key), ctx_(nullptr) {
     if (key.size() != 32) {
         throw std::runtime_error("Invalid key size: Expected 32 bytes");
     }
-    
-    if (iv.size() != 16) {
-        throw std::runtime_error("Invalid IV size: Expected 16 bytes");
+    if (mode != CipherMode::AES_256_CBC && mode != CipherMode::AES_256_GCM) {
+        throw std::runtime_error("Unsupported cipher mode");
     }
 
-    // Create and initialize the context
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if (!ctx) {
+    ctx_ = EVP_CIPHER_CTX_new();
+    if (!ctx_) {
         throw std::runtime_error("Failed to create cipher context: " + getOpenSSLErrors());
     }
 
-    // Initialize the encryption operation
-    if (EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, 
-                          reinterpret_cast<const unsigned char*>(key.data()), 
-                          reinterpret_cast<const unsigned char*>(iv.data())) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw std::runtime_error("Failed to initialize encryption: " + getOpenSSLErrors());
+    // Expand the key schedule once; each chunk then only supplies a new IV
+    int encrypting = direction == CipherDirection::Encrypt ? 1 : 0;
+    const unsigned char* keyBytes = reinterpret_cast<const unsigned char*>(key.data());
+    bool ok = EVP_CipherInit_ex(ctx_, cipherFor(mode), NULL, NULL, NULL, encrypting) == 1;
+    if (ok && mode == CipherMode::AES_256_GCM) {
+        ok = EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(kGcmNonceSize), NULL) == 1;
+    }
+    ok = ok && EVP_CipherInit_ex(ctx_, NULL, NULL, keyBytes, NULL, encrypting) == 1;
+    if (!ok) {
+        EVP_CIPHER_CTX_free(ctx_);
+        throw std::runtime_error(std::string("Failed to initialize ") +
+                                 (encrypting ? "encryption: " : "decryption: ") + getOpenSSLErrors());
+    }
+}
+
+CipherContext::~CipherContext() {
+    EVP_CIPHER_CTX_free(ctx_);
+    if (!key_.empty()) {
+        OPENSSL_cleanse(&key_[0], key_.size());
     }
+}
 
-    // Provide the message to be encrypted, and obtain the encrypted output
-    std::vector<unsigned char> ciphertext(data.size() + EVP_MAX_BLOCK_LENGTH);
-    int len;
-    int ciphertext_len;
+bool CipherContext::matches(CipherMode mode, CipherDirection direction, const std::string& key) const {
+    return mode_ == mode && direction_ == direction && key_ == key;
+}
+
+void CipherContext::resetIV(const std::string& iv, uint64_t chunkIndex) {
+    std::string chunkIV;
+    if (mode_ == CipherMode::AES_256_GCM) {
+        chunkIV = AESCrypto::chunkNonce(iv, chunkIndex);
+    } else {
+        if (iv.size() != 16) {
+            throw std::runtime_error("Invalid IV size: Expected 16 bytes");
+        }
+        chunkIV = iv;
+    }
+
+    // Passing NULL cipher and key keeps the expanded key and only restarts the
+    // operation with the new IV
+    int encrypting = direction_ == CipherDirection::Encrypt ? 1 : 0;
+    if (EVP_CipherInit_ex(ctx_, NULL, NULL, NULL,
+                          reinterpret_cast<const unsigned char*>(chunkIV.data()), encrypting) != 1) {
+        throw std::runtime_error(std::string("Failed to initialize ") +
+                                 (encrypting ? "encryption: " : "decryption: ") + getOpenSSLErrors());
+    }
+
+    // GCM bytes past the nonce are associated data, authenticated with every chunk
+    int len = 0;
+    if (mode_ == CipherMode::AES_256_GCM && iv.size() > kGcmNonceSize &&
+        EVP_CipherUpdate(ctx_, NULL, &len, reinterpret_cast<const unsigned char*>(iv.data()) + kGcmNonceSize,
+                         static_cast<int>(iv.size() - kGcmNonceSize)) != 1) {
+        throw std::runtime_error("Failed to set GCM associated data: " + getOpenSSLErrors());
+    }
+}
+
+static void checkAliasing(ConstByteSpan input, MutableByteSpan output) {
+    // OpenSSL handles exact in-place operation but not partially overlapping buffers
+    const unsigned char* in = input.data;
+    const unsigned char* out = output.data;
+    if (in != out && in < out + output.size && out < in + input.size) {
+        throw std::runtime_error("Input and output buffers overlap");
+    }
+}
+
+size_t CipherContext::encrypt(ConstByteSpan input, MutableByteSpan output,
+                              const std::string& iv, uint64_t chunkIndex) {
+    if (direction_ != CipherDirection::Encrypt) {
+        throw std::runtime_error("Cipher context was initialized for decryption");
+    }
+    size_t required = AESCrypto::encryptedSize(input.size, mode_);
+    if (output.size < required) {
+        throw std::runtime_error("Output buffer too small: " + std::to_string(output.size) +
+                                 " bytes, need " + std::to_string(required));
+    }
+    checkAliasing(input, output);
+    resetIV(iv, chunkIndex);
+
+    bool gcm = mode_ == CipherMode::AES_256_GCM;
+    int len = 0;
+    if (EVP_EncryptUpdate(ctx_, output.data, &len, input.data, static_cast<int>(input.size)) != 1) {
+        throw std::runtime_error(std::string(gcm ? "GCM encryption" : "Encryption") +
+                                 " update failed: " + getOpenSSLErrors());
+    }
+    size_t written = static_cast<size_t>(len);
+
+    if (EVP_EncryptFinal_ex(ctx_, output.data + written, &len) != 1) {
+        throw std::runtime_error(std::string(gcm ? "Final GCM encryption" : "Final encryption") +
+                                 " failed: " + getOpenSSLErrors());
+    }
+    written += static_cast<size_t>(len);
+
+    // GCM output is the plaintext length followed by the tag
+    if (gcm) {
+        if (EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_GET_TAG, static_cast<int>(kGcmTagSize),
+                                output.data + written) != 1) {
+            throw std::runtime_error("Final GCM encryption failed: " + getOpenSSLErrors());
+        }
+        written += kGcmTagSize;
+    }
+    return written;
+}
+
+size_t CipherContext::decrypt(ConstByteSpan input, MutableByteSpan output,
+                              const std::string& iv, uint64_t chunkIndex) {
+    if (direction_ != CipherDirection::Decrypt) {
+        throw std::runtime_error("Cipher context was initialized for encryption");
+    }
+
+    bool gcm = mode_ == CipherMode::AES_256_GCM;
+    size_t dataSize = input.size;
+    if (gcm) {
+        if (dataSize < kGcmTagSize) {
+            throw std::runtime_error("Invalid encrypted data size: Missing authentication tag");
+        }
+        dataSize -= kGcmTagSize;
+    } else if (dataSize < 16 || dataSize % 16 != 0) {
+        throw std::runtime_error("Invalid encrypted data size: Must be multiple of 16 bytes");
+    }
+    size_t required = AESCrypto::maxDecryptedSize(input.size, mode_);
+    if (output.size < required) {
+        throw std::runtime_error("Output buffer too small: " + std::to_string(output.size) +
+                                 " bytes, need " + std::to_string(required));
+    }
+    checkAliasing(input, output);
+    resetIV(iv, chunkIndex);
+
+    // Take the tag before decrypting, in case output aliases input
+    unsigned char tag[kGcmTagSize];
+    if (gcm) {
+        std::memcpy(tag, input.data + dataSize, kGcmTagSize);
+    }
 
-    if (EVP_EncryptUpdate(ctx, ciphertext.data(), &len, 
-                         reinterpret_cast<const unsigned char*>(data.data()), 
-                         data.size()) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw std::runtime_error("Encryption update failed: " + getOpenSSLErrors());
+    int len = 0;
+    if (EVP_DecryptUpdate(ctx_, output.data, &len, input.data, static_cast<int>(dataSize)) != 1) {
+        throw std::runtime_error(std::string(gcm ? "GCM decryption" : "Decryption") +
+                                 " update failed: " + getOpenSSLErrors());
     }
-    ciphertext_len = len;
+    size_t written = static_cast<size_t>(len);
 
-    // Finalize the encryption - add padding if necessary
-    if (EVP_EncryptFinal_ex(ctx, ciphertext.data() + len, &len) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw std::runtime_error("Final encryption failed: " + getOpenSSLErrors());
+    if (gcm) {
+        // The tag check happens in the final call; a mismatch means the chunk was
+        // modified, truncated or moved to a different index
+        if (EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_GCM_SET_TAG, static_cast<int>(kGcmTagSize), tag) != 1 ||
+            EVP_DecryptFinal_ex(ctx_, output.data + written, &len) != 1) {
+            ERR_clear_error();
+            throw std::runtime_error("Authentication failed for chunk " + std::to_string(chunkIndex) +
+                                     ": data has been tampered with or the key is wrong");
+        }
+    } else if (EVP_DecryptFinal_ex(ctx_, output.data + written, &len) != 1) {
+        throw std::runtime_error("Final decryption failed: " + getOpenSSLErrors());
     }
-    ciphertext_len += len;
+    written += static_cast<size_t>(len);
+    return written;
+}
 
-    // Clean up and return result
-    ciphertext.resize(ciphertext_len);
-    EVP_CIPHER_CTX_free(ctx);
+std::vector<unsigned char> CipherContext::encrypt(const std::vector<char>& data,
+                                                  const std::string& iv,
+                                                  uint64_t chunkIndex) {
+    std::vector<unsigned char> ciphertext(AESCrypto::encryptedSize(data.size(), mode_));
+    ciphertext.resize(encrypt(data, ciphertext, iv, chunkIndex));
     return ciphertext;
 }
 
+std::vector<char> CipherContext::decrypt(const std::vector<unsigned char>& encryptedData,
+                                         const std::string& iv,
+                                         uint64_t chunkIndex) {
+    std::vector<char> plaintext(AESCrypto::maxDecryptedSize(encryptedData.size(), mode_));
+    plaintext.resize(decrypt(encryptedData, plaintext, iv, chunkIndex));
+    return plaintext;
+}
+
+CipherContext& AESCrypto::context(CipherMode mode, CipherDirection direction, const std::string& key) {
+    // Most recently used first. Worker threads each see a handful of keys at
+    // most, so a linear scan over a short list is cheaper than hashing keys.
+    thread_local std::list<std::unique_ptr<CipherContext>> cache;
+
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if ((*it)->matches(mode, direction, key)) {
+            if (it != cache.begin()) {
+                cache.splice(cache.begin(), cache, it);
+            }
+            return *cache.front();
+        }
+    }
+
+    cache.push_front(std::unique_ptr<CipherContext>(new CipherContext(mode, direction, key)));
+    if (cache.size() > kContextCacheSize) {
+        cache.pop_back();
+    }
+    return *cache.front();
+}
+
+std::vector<unsigned char> AESCrypto::encrypt(const std::vector<char>& data, 
+                                             const std::string& key, 
+                                             const std::string& iv) {
+    return encrypt(CipherMode::AES_256_CBC, data, key, iv, 0);
+}
+
 std::vector<char> AESCrypto::decrypt(const std::vector<unsigned char>& encryptedData, 
                                     const std::string& key, 
                                     const std::string& iv) {
-    // Check key and IV size
-    if (key.size() != 32) {
-        throw std::runtime_error("Invalid key size: Expected 32 bytes");
+    return decrypt(CipherMode::AES_256_CBC, encryptedData, key, iv, 0);
+}
+
+std::string AESCrypto::chunkNonce(const std::string& fileNonce, uint64_t chunkIndex) {
+    if (fileNonce.size() < kGcmNonceSize) {
+        throw std::runtime_error("Invalid nonce size: Expected 12 bytes");
     }
     
-    if (iv.size() != 16) {
-        throw std::runtime_error("Invalid IV size: Expected 16 bytes");
+    // Distinct chunk indexes always give distinct nonces under the same key
+    std::string nonce = fileNonce.substr(0, kGcmNonceSize);
+    for (size_t i = 0; i < 8; ++i) {
+        nonce[kGcmNonceSize - 1 - i] ^= static_cast<char>((chunkIndex >> (8 * i)) & 0xFF);
     }
-    
-    // Ensure the encrypted data has at least one block
-    if (encryptedData.size() < 16 || encryptedData.size() % 16 != 0) {
-        throw std::runtime_error("Invalid encrypted data size: Must be multiple of 16 bytes");
+    return nonce;
+}
+
+std::vector<unsigned char> AESCrypto::encrypt(CipherMode mode,
+                                             const std::vector<char>& data,
+                                             const std::string& key,
+                                             const std::string& iv,
+                                             uint64_t chunkIndex) {
+    return context(mode, CipherDirection::Encrypt, key).encrypt(data, iv, chunkIndex);
+}
+
+std::vector<char> AESCrypto::decrypt(CipherMode mode,
+                                    const std::vector<unsigned char>& encryptedData,
+                                    const std::string& key,
+                                    const std::string& iv,
+                                    uint64_t chunkIndex) {
+    return context(mode, CipherDirection::Decrypt, key).decrypt(encryptedData, iv, chunkIndex);
+}
+
+size_t AESCrypto::encrypt(CipherMode mode, ConstByteSpan input, MutableByteSpan output,
+                          const std::string& key, const std::string& iv, uint64_t chunkIndex) {
+    return context(mode, CipherDirection::Encrypt, key).encrypt(input, output, iv, chunkIndex);
+}
+
+size_t AESCrypto::decrypt(CipherMode mode, ConstByteSpan input, MutableByteSpan output,
+                          const std::string& key, const std::string& iv, uint64_t chunkIndex) {
+    return context(mode, CipherDirection::Decrypt, key).decrypt(input, output, iv, chunkIndex);
+}
+
+size_t AESCrypto::encryptedSize(size_t plaintextSize, CipherMode mode) {
+    if (mode == CipherMode::AES_256_GCM) {
+        return plaintextSize + kGcmTagSize;
     }
+    // PKCS#7 always adds between 1 and 16 bytes of padding
+    return (plaintextSize / 16 + 1) * 16;
+}
 
-    // Create and initialize the context
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if (!ctx) {
-        throw std::runtime_error("Failed to create cipher context: " + getOpenSSLErrors());
+size_t AESCrypto::maxDecryptedSize(size_t encryptedSize, CipherMode mode) {
+    if (mode == CipherMode::AES_256_GCM) {
+        return encryptedSize > kGcmTagSize ? encryptedSize - kGcmTagSize : 0;
     }
+    // OpenSSL may write the whole final block before it strips the padding
+    return encryptedSize;
+}
 
-    // Initialize the decryption operation
-    if (EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, 
-                          reinterpret_cast<const unsigned char*>(key.data()), 
-                          reinterpret_cast<const unsigned char*>(iv.data())) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw std::runtime_error("Failed to initialize decryption: " + getOpenSSLErrors());
+std::string AESCrypto::generateNonce() {
+    std::string nonce(kGcmNonceSize, '\0');
+    if (RAND_bytes(reinterpret_cast<unsigned char*>(&nonce[0]), nonce.size()) != 1) {
+        throw std::runtime_error("Failed to generate random nonce: " + getOpenSSLErrors());
     }
+    return nonce;
+}
 
-    // Provide the ciphertext to be decrypted, and obtain the plaintext output
-    std::vector<char> plaintext(encryptedData.size());
-    int len;
-    int plaintext_len;
+CipherMode AESCrypto::parseCipherMode(const std::string& name) {
+    if (name == "cbc" || name == "aes-256-cbc") {
+        return CipherMode::AES_256_CBC;
+    }
+    if (name == "gcm" || name == "aes-256-gcm") {
+        return CipherMode::AES_256_GCM;
+    }
+    throw std::runtime_error("Unknown cipher mode: " + name + " (expected cbc or gcm)");
+}
 
-    if (EVP_DecryptUpdate(ctx, reinterpret_cast<unsigned char*>(plaintext.data()), &len, 
-                         encryptedData.data(), encryptedData.size()) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw std::runtime_error("Decryption update failed: " + getOpenSSLErrors());
+std::string AESCrypto::cipherModeName(CipherMode mode) {
+    switch (mode) {
+        case CipherMode::AES_256_CBC:
+            return "aes-256-cbc";
+        case CipherMode::AES_256_GCM:
+            return "aes-256-gcm";
     }
-    plaintext_len = len;
+    return "unknown";
+}
 
-    // Finalize the decryption - handle padding
-    if (EVP_DecryptFinal_ex(ctx, reinterpret_cast<unsigned char*>(plaintext.data()) + len, &len) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw std::runtime_error("Final decryption failed: " + getOpenSSLErrors());
+std::vector<CipherMode> AESCrypto::availableModes() {
+    std::vector<CipherMode> modes;
+    for (CipherMode mode : {CipherMode::AES_256_CBC, CipherMode::AES_256_GCM}) {
+        try {
+            cipherFor(mode);
+            modes.push_back(mode);
+        } catch (const std::exception&) {
+            ERR_clear_error();
+        }
     }
-    plaintext_len += len;
+    return modes;
+}
 
-    // Clean up and return result
-    plaintext.resize(plaintext_len);
-    EVP_CIPHER_CTX_free(ctx);
-    return plaintext;
+bool AESCrypto::hardwareAes() {
+    // CPUID leaf 1, ECX bit 25
+#ifdef _MSC_VER
+    int info[4] = {0};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 25)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 25)) != 0;
+#else
+    return false;
+#endif
 }
 
 void AESCrypto::generateKeyIV(std::string& key, std::string& iv) {
@@ -0,0 +1,1431 @@
+#include "dispatcher.h"
+#include "wire.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+ChunkDispatcher::ChunkDispatcher(const std::vector<std::shared_ptr<ChannelPool>>& workers,
+                                 size_t maxInFlightPerWorker)
+    : workers_(workers),
+      maxInFlightPerWorker_(std::max<size_t>(1, maxInFlightPerWorker)) {
+}
+
+ChunkDispatcher::WorkerStream::WorkerStream(size_t workerIndex)
+    : workerIndex(workerIndex),
+      startTag(Tag::Kind::StreamStart, this),
+      readTag(Tag::Kind::StreamRead, this),
+      writeTag(Tag::Kind::StreamWrite, this),
+      writesDoneTag(Tag::Kind::StreamWritesDone, this),
+      finishTag(Tag::Kind::StreamFinish, this) {
+}
+
+void ChunkDispatcher::fillRequest(encryption::ChunkRequest& request, const FileChunk& chunk, size_t workerIndex,
+                                  const std::string& key, const std::string& iv, bool withData) const {
+    if (sharedStorage()) {
+        request.set_input_path(sharedInput_);
+        request.set_input_offset(chunk.offset);
+        request.set_input_length(chunk.length);
+        request.set_output_path(sharedOutput_);
+        request.set_output_offset(chunk.outputOffset);
+    } else if (withData) {
+        request.set_data(chunk.bytes(), chunk.byteCount());
+    }
+    request.set_chunk_id(chunk.id);
+    if (sessions_[workerIndex] != 0) {
+        request.set_session_id(sessions_[workerIndex]);
+    } else {
+        request.set_key(key.data(), key.size());
+        request.set_iv(iv.data(), iv.size());
+        request.set_cipher(static_cast<encryption::Cipher>(cipherMode_));
+    }
+}
+
+// Sends the chunk through ChunkWire, so the request references its bytes
+// instead of copying them
+grpc::ByteBuffer ChunkDispatcher::encodeRequest(FileChunk& chunk, const encryption::ChunkRequest& fields) {
+    if (sharedStorage()) {
+        return ChunkWire::encodeRequest(fields, nullptr);
+    }
+    bytesMoved_ += chunk.byteCount();
+    return ChunkWire::encodeRequest(fields, chunk.share());
+}
+
+void ChunkDispatcher::startCall(FileChunk&& chunk, size_t index, size_t workerIndex,
+                                ChunkOperation operation, const std::string& key, const std::string& iv) {
+    auto call = std::make_unique<PendingCall>(&arenaStats_);
+    auto* fields = call->arena.create<encryption::ChunkRequest>();
+    fillRequest(*fields, chunk, workerIndex, key, iv, false);
+    const char* method = operation == ChunkOperation::Encrypt ? ChunkWire::kEncryptChunk : ChunkWire::kDecryptChunk;
+    if (sharedStorage()) {
+        fields->set_operation(operation == ChunkOperation::Encrypt ? encryption::OPERATION_ENCRYPT
+                                                                   : encryption::OPERATION_DECRYPT);
+        method = ChunkWire::kProcessRange;
+    }
+    // Through the worker's ring when a slot is free: one copy into shared
+    // memory and the request carries only the slot
+    SharedRing* ring = workerIndex < rings_.size() ? rings_[workerIndex].get() : nullptr;
+    if (ring && chunk.byteCount() + kCipherOverhead <= ring->slotSize()) {
+        call->ringSlot = ring->acquire();
+    }
+    grpc::ByteBuffer request;
+    if (call->ringSlot != SharedRing::kNoSlot) {
+        call->ring = ring;
+        std::memcpy(ring->slotData(call->ringSlot), chunk.bytes(), chunk.byteCount());
+        fields->set_ring_id(ringIds_[workerIndex]);
+        fields->set_ring_offset(ring->slotOffset(call->ringSlot));
+        fields->set_ring_capacity(ring->slotSize());
+        fields->set_input_length(chunk.byteCount());
+        bytesMoved_ += chunk.byteCount();
+        bytesCopied_ += chunk.byteCount();
+        request = ChunkWire::encodeRequest(*fields, nullptr);
+    } else {
+        request = encodeRequest(chunk, *fields);
+    }
+
+    call->index = index;
+    call->workerIndex = workerIndex;
+    call->context.set_deadline(std::chrono::system_clock::now() + callTimeout_);
+    call->input = std::move(chunk);
+    call->sentAt = WorkerScheduler::Clock::now();
+    auto state = active_.find(index);
+    call->hedge = state != active_.end() && state->second.attempts > 0;
+
+    // The call holds its connection until the call object is deleted
+    call->channel = workers_[workerIndex]->lease();
+    call->reader = call->channel.generic().PrepareUnaryCall(&call->context, method, request, cq_.get());
+    call->reader->StartCall();
+
+    // The call object itself is the completion tag; it is reclaimed in dispatch()
+    PendingCall* tag = call.release();
+    tag->reader->Finish(&tag->reply, &tag->status, tag);
+    outstanding_.insert(tag);
+    trackAttempt(index, workerIndex, &tag->input, tag);
+    ++inFlight_[workerIndex];
+}
+
+void ChunkDispatcher::startAttempt(FileChunk&& chunk, size_t index, size_t workerIndex,
+                                   ChunkOperation operation, const std::string& key, const std::string& iv) {
+    if (isLocal(workerIndex)) {
+        startLocal(std::move(chunk), index, operation, key, iv);
+    } else {
+        startCall(std::move(chunk), index, workerIndex, operation, key, iv);
+    }
+}
+
+// Runs the chunk on a pool thread exactly as a worker would, writing straight
+// into the response, and posts the result to the completion queue
+void ChunkDispatcher::startLocal(FileChunk&& chunk, size_t index, ChunkOperation operation,
+                                 const std::string& key, const std::string& iv) {
+    auto local = std::make_unique<PendingLocal>();
+    local->index = index;
+    local->workerIndex = localIndex_;
+    local->input = std::move(chunk);
+    local->sentAt = WorkerScheduler::Clock::now();
+
+    // The key and IV outlive the task: dispatch() waits for every local task
+    PendingLocal* tag = local.release();
+    localOutstanding_.insert(tag);
+    trackAttempt(index, tag->workerIndex, &tag->input, nullptr);
+    ++inFlight_[tag->workerIndex];
+
+    CipherMode mode = cipherMode_;
+    grpc::CompletionQueue* cq = cq_.get();
+    localPool_->submit([tag, cq, mode, operation, &key, &iv]() {
+        encryption::ChunkResponse& response = tag->response;
+        try {
+            ConstByteSpan input(tag->input.bytes(), tag->input.byteCount());
+            std::string* output = response.mutable_processed_data();
+            uint64_t chunkIndex = static_cast<uint64_t>(tag->input.id);
+            size_t size = 0;
+            if (operation == ChunkOperation::Encrypt) {
+                CipherContext& cipher = AESCrypto::context(mode, CipherDirection::Encrypt, key);
+                output->resize(AESCrypto::encryptedSize(input.size, mode));
+                size = cipher.encrypt(input, *output, iv, chunkIndex);
+            } else {
+                CipherContext& cipher = AESCrypto::context(mode, CipherDirection::Decrypt, key);
+                output->resize(AESCrypto::maxDecryptedSize(input.size, mode));
+                size = cipher.decrypt(input, *output, iv, chunkIndex);
+            }
+            output->resize(size);
+            response.set_chunk_id(tag->input.id);
+            response.set_success(true);
+        } catch (const std::exception& e) {
+            response.clear_processed_data();
+            response.set_success(false);
+            response.set_error_message(std::string("Local ") +
+                                       (operation == ChunkOperation::Encrypt ? "encryption" : "decryption") +
+                                       " error: " + e.what());
+        }
+        tag->alarm.Set(cq, gpr_now(GPR_CLOCK_MONOTONIC), tag);
+    });
+}
+
+void ChunkDispatcher::startBatch(BatchItems&& items, size_t workerIndex,
+                                 ChunkOperation operation, const std::string& key, const std::string& iv) {
+    auto batch = std::make_unique<PendingBatch>(&arenaStats_);
+    auto* request = batch->arena.create<encryption::BatchRequest>();
+    request->mutable_chunks()->Reserve(static_cast<int>(items.size()));
+    for (const auto& item : items) {
+        fillRequest(*request->add_chunks(), item.second, workerIndex, key, iv);
+        bytesMoved_ += item.second.byteCount();
+        bytesCopied_ += 2 * item.second.byteCount();  // Into the message, then serialized
+    }
+
+    batch->workerIndex = workerIndex;
+    batch->context.set_deadline(std::chrono::system_clock::now() + callTimeout_);
+    batch->items = std::move(items);
+    batch->sentAt = WorkerScheduler::Clock::now();
+
+    batch->channel = workers_[workerIndex]->lease();
+    if (operation == ChunkOperation::Encrypt) {
+        batch->reader = batch->channel->PrepareAsyncEncryptBatch(&batch->context, *request, cq_.get());
+    } else {
+        batch->reader = batch->channel->PrepareAsyncDecryptBatch(&batch->context, *request, cq_.get());
+    }
+    batch->reader->StartCall();
+
+    PendingBatch* tag = batch.release();
+    tag->reader->Finish(tag->response, &tag->status, tag);
+    outstandingBatches_.insert(tag);
+    for (const auto& item : tag->items) {
+        trackAttempt(item.first, workerIndex, &item.second, nullptr);
+    }
+    ++inFlight_[workerIndex];
+}
+
+void ChunkDispatcher::trackAttempt(size_t index, size_t workerIndex, const FileChunk* input, PendingCall* call) {
+    ChunkState& state = active_[index];
+    if (state.attempts++ == 0) {
+        state.workerIndex = workerIndex;
+        state.sentAt = WorkerScheduler::Clock::now();
+        state.input = input;
+    }
+    if (call) {
+        state.calls.push_back(call);
+    }
+}
+
+// Forgets an attempt that is about to be re-sent by other means (e.g. stream fallback)
+void ChunkDispatcher::dropAttempt(size_t index) {
+    auto it = active_.find(index);
+    if (it != active_.end() && it->second.attempts > 0) {
+        --it->second.attempts;
+    }
+}
+
+double ChunkDispatcher::hedgeThresholdMs() const {
+    std::vector<double> samples(latencySamples_.begin(), latencySamples_.end());
+    double fraction = std::min(hedgePercentile_, 100.0) / 100.0;
+    size_t rank = static_cast<size_t>(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
+
+bool ChunkDispatcher::reserveBudget() {
+    if (memoryBudget_ && !memoryBudget_->tryAcquire(budgetPerChunk_)) {
+        return false;
+    }
+    ++reservedChunks_;
+    return true;
+}
+
+void ChunkDispatcher::releaseBudget(size_t chunks) {
+    chunks = std::min(chunks, reservedChunks_);
+    reservedChunks_ -= chunks;
+    if (memoryBudget_) {
+        memoryBudget_->release(chunks * budgetPerChunk_);
+    }
+}
+
+void ChunkDispatcher::startProbe(size_t workerIndex) {
+    encryption::TestRequest request;
+    request.set_test_message("ping");
+
+    auto probe = std::make_unique<PendingProbe>();
+    probe->workerIndex = workerIndex;
+    probe->context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    probe->channel = workers_[workerIndex]->lease();
+    probe->reader = probe->channel->PrepareAsyncTestConnection(&probe->context, request, cq_.get());
+    probe->reader->StartCall();
+
+    PendingProbe* tag = probe.release();
+    tag->reader->Finish(&tag->response, &tag->status, tag);
+    probes_.insert(tag);
+    probeDue_[workerIndex] = WorkerScheduler::Clock::time_point::max();
+}
+
+void ChunkDispatcher::cancelOutstanding() {
+    for (PendingCall* call : outstanding_) {
+        call->context.TryCancel();
+    }
+    for (PendingBatch* batch : outstandingBatches_) {
+        batch->context.TryCancel();
+    }
+    for (PendingProbe* probe : probes_) {
+        probe->context.TryCancel();
+    }
+    for (auto& stream : streams_) {
+        if (stream) {
+            stream->context.TryCancel();
+        }
+    }
+}
+
+void ChunkDispatcher::openStreams() {
+    streams_.clear();
+    if (!useStreaming_ || maxBatchChunks_ > 1 || localOnly_ || sharedStorage()) {
+        return;
+    }
+
+    // One stream per connection, so a worker with several connections gets
+    // several streams. They carry no deadline, since they live for the whole
+    // job; errors elsewhere cancel them through cancelOutstanding().
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        if (!isRemote(i) || retiring(i) || !activeScheduler().available(i)) {
+            continue;  // Gets unary calls if it comes back during the job
+        }
+        if (i < rings_.size() && rings_[i]) {
+            continue;  // Chunks go through its ring
+        }
+        for (size_t c = 0; c < workers_[i]->size(); ++c) {
+            auto stream = std::make_unique<WorkerStream>(i);
+            stream->channel = workers_[i]->lease();
+            stream->stream = stream->channel.generic().PrepareCall(&stream->context, ChunkWire::kProcessChunks, cq_.get());
+            stream->stream->StartCall(&stream->startTag);
+            ++stream->opsPending;
+            streams_.push_back(std::move(stream));
+        }
+    }
+}
+
+// The worker's open stream with the fewest chunks pending, or null
+ChunkDispatcher::WorkerStream* ChunkDispatcher::streamFor(size_t workerIndex) {
+    WorkerStream* best = nullptr;
+    for (auto& stream : streams_) {
+        if (stream->workerIndex != workerIndex || stream->readClosed || stream->writesDone) {
+            continue;
+        }
+        if (!best || stream->pending.size() < best->pending.size()) {
+            best = stream.get();
+        }
+    }
+    return best;
+}
+
+void ChunkDispatcher::sendOnStream(WorkerStream& stream, FileChunk&& chunk, size_t index,
+                                   ChunkOperation operation, const std::string& key, const std::string& iv) {
+    // The frame is encoded right away, so its fields only need the arena until then
+    requestFrames_.reset();
+    auto* fields = requestFrames_.create<encryption::ChunkRequest>();
+    fillRequest(*fields, chunk, stream.workerIndex, key, iv, false);
+    fields->set_operation(operation == ChunkOperation::Encrypt ? encryption::OPERATION_ENCRYPT
+                                                               : encryption::OPERATION_DECRYPT);
+    fields->set_request_id(index);
+
+    stream.writeQueue.push_back(encodeRequest(chunk, *fields));
+    auto it = stream.pending.emplace(index, StreamedChunk{std::move(chunk), WorkerScheduler::Clock::now()}).first;
+    trackAttempt(index, stream.workerIndex, &it->second.input, nullptr);
+    ++inFlight_[stream.workerIndex];
+}
+
+// Issues whatever the stream can do next: the next queued write, WritesDone
+// once nothing more will be sent, or Finish once the worker has closed its side
+void ChunkDispatcher::pumpStream(WorkerStream& stream, bool sourceDone) {
+    if (!stream.started || stream.finishing) {
+        return;
+    }
+    if (stream.readClosed) {
+        if (!stream.writing) {
+            stream.finishing = true;
+            stream.stream->Finish(&stream.status, &stream.finishTag);
+            ++stream.opsPending;
+        }
+        return;
+    }
+    if (stream.writing || stream.writesDone) {
+        return;
+    }
+    if (!stream.writeQueue.empty()) {
+        // Only one write may be outstanding; HTTP/2 flow control decides when it completes
+        stream.writing = true;
+        stream.stream->Write(stream.writeQueue.front(), &stream.writeTag);
+        ++stream.opsPending;
+    } else if (sourceDone) {
+        stream.writesDone = true;
+        stream.stream->WritesDone(&stream.writesDoneTag);
+        ++stream.opsPending;
+    }
+}
+
+// Runs one unary control call per listed worker at once on a queue of its
+// own and waits for all of them, so a hung worker holds up the round until
+// the shared deadline rather than adding a timeout per worker. start issues
+// the call on the given connection; handle sees each worker's outcome.
+template <typename Response, typename Start, typename Handle>
+static void controlRound(const std::vector<std::shared_ptr<ChannelPool>>& workers,
+                         const std::vector<size_t>& targets,
+                         std::chrono::system_clock::time_point deadline,
+                         Start start, Handle handle) {
+    struct Call {
+        size_t workerIndex = 0;
+        ChannelPool::Lease channel;
+        grpc::ClientContext context;
+        Response response;
+        grpc::Status status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader;
+    };
+    if (targets.empty()) {
+        return;
+    }
+
+    grpc::CompletionQueue cq;
+    std::vector<std::unique_ptr<Call>> calls;
+    for (size_t workerIndex : targets) {
+        auto call = std::make_unique<Call>();
+        call->workerIndex = workerIndex;
+        call->context.set_deadline(deadline);
+        call->channel = workers[workerIndex]->lease();
+        call->reader = start(workerIndex, call->channel, &call->context, &cq);
+        call->reader->StartCall();
+        call->reader->Finish(&call->response, &call->status, call.get());
+        calls.push_back(std::move(call));
+    }
+
+    void* tag = nullptr;
+    bool ok = false;
+    for (size_t done = 0; done < calls.size() && cq.Next(&tag, &ok); ++done) {
+        Call* call = static_cast<Call*>(tag);
+        handle(call->workerIndex, call->status, call->response);
+    }
+    cq.Shutdown();
+    while (cq.Next(&tag, &ok)) {
+    }
+}
+
+void ChunkDispatcher::openSessions(const std::string& key, const std::string& iv,
+                                   std::chrono::system_clock::time_point deadline) {
+    sessions_.assign(workerCount(), 0);
+    if (!useSessions_ || localOnly_) {
+        return;
+    }
+
+    encryption::OpenSessionRequest request;
+    request.set_key(key.data(), key.size());
+    request.set_iv(iv.data(), iv.size());
+    request.set_cipher(static_cast<encryption::Cipher>(cipherMode_));
+
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        if (isRemote(i) && !retiring(i) && activeScheduler().available(i)) {
+            targets.push_back(i);
+        }
+    }
+    controlRound<encryption::OpenSessionResponse>(workers_, targets, deadline,
+        [&](size_t, ChannelPool::Lease& channel, grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+            return channel->PrepareAsyncOpenSession(context, request, cq);
+        },
+        [&](size_t i, const grpc::Status& status, const encryption::OpenSessionResponse& response) {
+            if (status.ok() && response.success()) {
+                sessions_[i] = response.session_id();
+            } else if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED) {
+                std::cout << "Worker " << i << " does not support sessions, sending keys with each chunk" << std::endl;
+            } else {
+                std::cerr << "Failed to open session on worker " << i << ": "
+                          << (status.ok() ? response.error_message() : status.error_message())
+                          << ", sending keys with each chunk" << std::endl;
+            }
+        });
+}
+
+void ChunkDispatcher::closeSessions(std::chrono::system_clock::time_point deadline) {
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < sessions_.size(); ++i) {
+        if (sessions_[i] != 0 && isRemote(i) && memberStates_[i] != MemberState::Gone &&
+            activeScheduler().available(i)) {
+            targets.push_back(i);
+        }
+    }
+
+    // Best effort: the worker evicts sessions that are never closed
+    controlRound<encryption::CloseSessionResponse>(workers_, targets, deadline,
+        [&](size_t i, ChannelPool::Lease& channel, grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+            encryption::CloseSessionRequest request;
+            request.set_session_id(sessions_[i]);
+            return channel->PrepareAsyncCloseSession(context, request, cq);
+        },
+        [&](size_t i, const grpc::Status& status, const encryption::CloseSessionResponse&) {
+            if (!status.ok()) {
+                std::cerr << "Failed to close session on worker " << i << ": " << status.error_message() << std::endl;
+            }
+        });
+    sessions_.clear();
+}
+
+// A ring per same-host worker, sized for its window plus as many slots again
+// for slots retired by cancelled calls
+void ChunkDispatcher::attachRings(std::chrono::system_clock::time_point deadline) {
+    rings_.clear();
+    ringIds_.assign(workerCount(), 0);
+    if (ringSlotSize_ == 0 || localOnly_ || sharedStorage()) {
+        return;
+    }
+
+    std::vector<size_t> targets;
+    std::vector<std::unique_ptr<SharedRing>> created(workerCount());
+    for (size_t i = 0; i < workers_.size() && i < sameHost_.size(); ++i) {
+        if (!sameHost_[i] || !isRemote(i) || retiring(i) || !activeScheduler().available(i)) {
+            continue;
+        }
+        size_t slots = 2 * std::max(maxInFlightPerWorker_, baseCapacity_[i]);
+        try {
+            created[i] = std::make_unique<SharedRing>(slots, ringSlotSize_);
+            targets.push_back(i);
+        } catch (const std::exception& e) {
+            std::cerr << "No shared-memory ring for worker " << i << ": " << e.what() << std::endl;
+        }
+    }
+
+    controlRound<encryption::AttachRingResponse>(workers_, targets, deadline,
+        [&](size_t i, ChannelPool::Lease& channel, grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+            encryption::AttachRingRequest request;
+            request.set_name(created[i]->name());
+            request.set_size(created[i]->size());
+            return channel->PrepareAsyncAttachRing(context, request, cq);
+        },
+        [&](size_t i, const grpc::Status& status, const encryption::AttachRingResponse& response) {
+            if (status.ok() && response.success()) {
+                std::cout << "Worker " << i << " attached a " << created[i]->size() / (1024 * 1024)
+                          << " MB shared-memory ring (" << created[i]->size() / ringSlotSize_ << " slots)" << std::endl;
+                if (rings_.size() <= i) {
+                    rings_.resize(i + 1);
+                }
+                rings_[i] = std::move(created[i]);
+                ringIds_[i] = response.ring_id();
+            } else if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED) {
+                std::cout << "Worker " << i << " does not support shared memory, sending chunks over gRPC" << std::endl;
+            } else {
+                std::cerr << "Worker " << i << " could not attach a shared-memory ring: "
+                          << (status.ok() ? response.error_message() : status.error_message())
+                          << ", sending chunks over gRPC" << std::endl;
+            }
+        });
+}
+
+void ChunkDispatcher::detachRings(std::chrono::system_clock::time_point deadline) {
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < rings_.size(); ++i) {
+        if (rings_[i] && isRemote(i) && memberStates_[i] != MemberState::Gone) {
+            targets.push_back(i);
+        }
+    }
+
+    // Best effort: the worker drops its oldest rings once it holds too many
+    controlRound<encryption::DetachRingResponse>(workers_, targets, deadline,
+        [&](size_t i, ChannelPool::Lease& channel, grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+            encryption::DetachRingRequest request;
+            request.set_ring_id(ringIds_[i]);
+            return channel->PrepareAsyncDetachRing(context, request, cq);
+        },
+        [&](size_t i, const grpc::Status& status, const encryption::DetachRingResponse&) {
+            if (!status.ok()) {
+                std::cerr << "Failed to detach ring from worker " << i << ": " << status.error_message() << std::endl;
+            }
+        });
+    rings_.clear();
+    ringIds_.clear();
+}
+
+// Copies a ring call's result out of its slot. The slot is reused only if the
+// worker is known to be done with it: a call that failed or was cancelled may
+// still be running there.
+void ChunkDispatcher::finishRingCall(PendingCall& call, grpc::Status& status) {
+    if (!status.ok()) {
+        return;  // Slot retired
+    }
+    const encryption::ChunkResponse& response = *call.response;
+    if (response.success()) {
+        uint64_t length = response.output_length();
+        if (length > call.ring->slotSize()) {
+            status = grpc::Status(grpc::StatusCode::INTERNAL, "ring result overflows its slot");
+            return;
+        }
+        const char* slot = call.ring->slotData(call.ringSlot);
+        call.output.assign(slot, slot + length);
+        bytesCopied_ += length;
+    }
+    call.ring->release(call.ringSlot);
+}
+
+// Applies the joins, drains and drops since the last sync. Workers that join
+// get unary calls with inline keys, like workers back from an outage.
+void ChunkDispatcher::syncMembership() {
+    uint64_t version = membership_->version();
+    if (version == membershipVersion_) {
+        return;
+    }
+    membershipVersion_ = version;
+    WorkerScheduler& scheduler = activeScheduler();
+    std::vector<WorkerMember> members = membership_->snapshot();
+
+    size_t count = std::max(members.size(), workers_.size());
+    if (count > workers_.size()) {
+        workers_.resize(count);
+        inFlight_.resize(count, 0);
+        capacity_.resize(count, 0);
+        baseCapacity_.resize(count, 0);
+        probeDelay_.resize(count, kProbeDelay);
+        probeDue_.resize(count, WorkerScheduler::Clock::time_point::max());
+        batchUnsupported_.resize(count, false);
+        sessions_.resize(count, 0);
+        memberStates_.resize(count, MemberState::Gone);  // Not yet seen
+    }
+    if (scheduler.size() < count) {
+        scheduler.resize(count);
+    }
+
+    for (size_t i = 0; i < members.size(); ++i) {
+        const WorkerMember& member = members[i];
+        if (!member.pool || isLocal(i)) {
+            continue;
+        }
+        workers_[i] = member.pool;
+        MemberState previous = memberStates_[i];
+        memberStates_[i] = member.state;
+        baseCapacity_[i] = member.state == MemberState::Active && !localOnly_
+            ? std::max(maxInFlightPerWorker_, member.capacity) : 0;
+        if (member.state == previous) {
+            continue;
+        }
+
+        if (member.state == MemberState::Active) {
+            std::cout << "Worker " << i << " (" << member.address << ") joined, sending it chunks" << std::endl;
+            scheduler.markAvailable(i);
+            sessions_[i] = 0;
+            batchUnsupported_[i] = false;
+            probeDelay_[i] = kProbeDelay;
+            probeDue_[i] = WorkerScheduler::Clock::time_point::max();
+        } else if (member.state == MemberState::Draining) {
+            std::cout << "Worker " << i << " is draining, sending it no more chunks" << std::endl;
+        } else {
+            // Out of rotation first, so the cancelled attempts below do not
+            // count against it, then everything it holds is resent elsewhere
+            std::cerr << "Worker " << i << " (" << member.address << ") left";
+            if (inFlight_[i] > 0) {
+                std::cerr << ", resending its " << inFlight_[i] << " outstanding chunks";
+            }
+            std::cerr << std::endl;
+            scheduler.markUnavailable(i);
+            probeDue_[i] = WorkerScheduler::Clock::time_point::max();
+            for (PendingCall* call : outstanding_) {
+                if (call->workerIndex == i) {
+                    call->context.TryCancel();
+                }
+            }
+            for (PendingBatch* batch : outstandingBatches_) {
+                if (batch->workerIndex == i) {
+                    batch->context.TryCancel();
+                }
+            }
+            for (auto& stream : streams_) {
+                if (stream && stream->workerIndex == i) {
+                    stream->context.TryCancel();
+                }
+            }
+        }
+    }
+    capacity_ = baseCapacity_;
+}
+
+void ChunkDispatcher::dispatch(const std::vector<FileChunk>& chunks,
+                               ChunkOperation operation,
+                               const std::string& key,
+                               const std::string& iv,
+                               const CompletionHandler& onComplete,
+                               const FailureHandler& onFailure) {
+    size_t next = 0;
+    dispatch([&](FileChunk& chunk) {
+                 if (next >= chunks.size()) {
+                     return false;
+                 }
+                 chunk = chunks[next++];
+                 return true;
+             },
+             operation, key, iv, onComplete, onFailure);
+}
+
+void ChunkDispatcher::dispatch(const ChunkSource& source,
+                               ChunkOperation operation,
+                               const std::string& key,
+                               const std::string& iv,
+                               const CompletionHandler& onComplete,
+                               const FailureHandler& onFailure) {
+    if (sharedStorage() && localPool_) {
+        std::cout << "Shared-storage ranges go to the remote workers only; not using the local pool" << std::endl;
+        localPool_ = nullptr;
+        localOnly_ = false;
+    }
+    if (membership_) {
+        // The local slot is reserved in the membership itself, so a worker
+        // that registers during the job can never be given its index
+        if (localPool_) {
+            localIndex_ = membership_->addLocal();
+        }
+        workers_ = membership_->pools();
+    } else if (localPool_) {
+        localIndex_ = std::find(workers_.begin(), workers_.end(), nullptr) - workers_.begin();
+        if (localIndex_ == workers_.size()) {
+            workers_.push_back(nullptr);
+        }
+    }
+    size_t remoteCount = workers_.size() - std::count(workers_.begin(), workers_.end(), nullptr);
+    if (remoteCount == 0 && !localPool_ && !membership_) {
+        throw std::runtime_error("No workers available for dispatch");
+    }
+
+    // A shared scheduler may already know of workers that joined since this
+    // dispatcher was made, so it only ever grows
+    WorkerScheduler& scheduler = activeScheduler();
+    if (scheduler.size() < workerCount()) {
+        scheduler.resize(workerCount());
+    }
+
+    // Remote workers get the configured window, the local pool a slot per
+    // thread, or two when it works alone so every deque has a task queued
+    capacity_.assign(workerCount(), 0);
+    for (size_t i = 0; i < workerCount(); ++i) {
+        if (isLocal(i)) {
+            capacity_[i] = localPool_->threadCount() * (localOnly_ ? 2 : 1);
+        } else if (isRemote(i) && !localOnly_) {
+            capacity_[i] = maxInFlightPerWorker_;
+        }
+    }
+    if (localPool_) {
+        scheduler.setExpectedThroughput(localIndex_, localPool_->threadCount() *
+                                                     LocalCryptoPool::calibratedThroughput(cipherMode_));
+    }
+    baseCapacity_ = capacity_;
+
+    cq_ = std::make_unique<grpc::CompletionQueue>();
+    inFlight_.assign(workerCount(), 0);
+    reservedChunks_ = 0;
+    outstanding_.clear();
+    outstandingBatches_.clear();
+    active_.clear();
+    latencySamples_.clear();
+    retries_.clear();
+    probes_.clear();
+    localOutstanding_.clear();
+    probeDelay_.assign(workerCount(), kProbeDelay);
+    probeDue_.assign(workerCount(), WorkerScheduler::Clock::time_point::max());
+    batchUnsupported_.assign(workerCount(), false);
+    sessions_.assign(workerCount(), 0);
+    memberStates_.assign(workerCount(), MemberState::Active);
+    if (membership_) {
+        membershipVersion_ = 0;
+        syncMembership();
+    }
+    for (size_t i = 0; i < workers_.size() && !localOnly_; ++i) {
+        if (isRemote(i) && memberStates_[i] != MemberState::Gone && !scheduler.available(i)) {
+            // Out of rotation since an earlier job; see if it is back
+            probeDue_[i] = WorkerScheduler::Clock::now();
+        }
+    }
+    bytesMoved_ = 0;
+    bytesCopied_ = 0;
+    arenaStats_.reset();
+    // Setup and teardown calls share one deadline per phase, however many
+    // workers there are
+    auto setupDeadline = std::chrono::system_clock::now() + kControlTimeout;
+    openSessions(key, iv, setupDeadline);
+    attachRings(setupDeadline);
+    openStreams();
+
+    const char* opName = operation == ChunkOperation::Encrypt ? "encrypt" : "decrypt";
+    std::cout << "Dispatching chunks (" << opName << ") to ";
+    if (localOnly_) {
+        std::cout << "the local pool only";
+    } else {
+        std::cout << remoteCount << " workers, " << maxInFlightPerWorker_ << " in flight per worker";
+    }
+    if (localPool_) {
+        std::cout << ", " << localPool_->threadCount() << " local threads as worker " << localIndex_;
+    }
+    if (sharedStorage()) {
+        std::cout << " as file ranges on shared storage";
+    } else if (maxBatchChunks_ > 1) {
+        std::cout << ", batches of up to " << maxBatchChunks_ << " chunks / " << maxBatchBytes_ << " bytes";
+    } else if (useStreaming_) {
+        std::cout << " over streams";
+    }
+    std::cout << std::endl;
+
+    size_t next = 0;
+    bool sourceDone = false;
+
+    // One chunk can be held back when it would push a batch over its byte budget
+    FileChunk lookahead;
+    bool haveLookahead = false;
+    // Every chunk read from the source holds a share of the memory budget
+    // until it settles; when the budget is spent, reading stalls until
+    // completions (and their writes) give some back
+    bool budgetStalled = false;
+    size_t budgetStalls = 0;
+    auto pull = [&](FileChunk& chunk) {
+        if (haveLookahead) {
+            chunk = std::move(lookahead);
+            haveLookahead = false;
+            return true;
+        }
+        if (sourceDone) {
+            return false;
+        }
+        if (!reserveBudget()) {
+            if (!budgetStalled) {
+                ++budgetStalls;
+            }
+            budgetStalled = true;
+            return false;
+        }
+        if (!source(chunk)) {
+            releaseBudget(1);
+            sourceDone = true;
+            return false;
+        }
+        return true;
+    };
+    auto exhausted = [&]() { return sourceDone && !haveLookahead; };
+
+    // Retries go to a worker other than the one that failed, unless it is the
+    // only one left in rotation
+    auto pickRetryWorker = [&](size_t failedWorker) {
+        std::vector<size_t> load = inFlight_;
+        if (scheduler.availableCount() > 1) {
+            load[failedWorker] = capacity_[failedWorker];
+        }
+        return scheduler.pick(load, capacity_);
+    };
+
+    // Send retries that are due, then pull the next chunks for whichever
+    // workers have free slots, least loaded first
+    auto fillWindows = [&]() {
+        budgetStalled = false;
+        if (fairShare_) {
+            // Other jobs start and finish meanwhile, so the share is re-read on every pass
+            double share = fairShare_->fraction(fairShareId_);
+            for (size_t i = 0; i < capacity_.size(); ++i) {
+                capacity_[i] = baseCapacity_[i] == 0 ? 0 :
+                    std::max<size_t>(1, static_cast<size_t>(std::lround(baseCapacity_[i] * share)));
+            }
+        }
+        auto now = WorkerScheduler::Clock::now();
+        while (!retries_.empty() && retries_.begin()->first <= now) {
+            RetryItem& item = retries_.begin()->second;
+            size_t workerIndex = pickRetryWorker(item.failedWorker);
+            if (workerIndex >= workerCount()) {
+                break;
+            }
+            startAttempt(std::move(item.input), item.index, workerIndex, operation, key, iv);
+            retries_.erase(retries_.begin());
+        }
+
+        while (!exhausted()) {
+            size_t workerIndex = scheduler.pick(inFlight_, capacity_);
+            if (workerIndex >= workerCount()) {
+                break;
+            }
+            FileChunk chunk;
+            if (!pull(chunk)) {
+                break;
+            }
+            WorkerStream* stream = streamFor(workerIndex);
+            if (stream) {
+                sendOnStream(*stream, std::move(chunk), next++, operation, key, iv);
+            } else if (maxBatchChunks_ > 1 && !batchUnsupported_[workerIndex] && !isLocal(workerIndex) &&
+                       !sharedStorage()) {
+                // Pack following chunks into the same call until a budget is reached
+                size_t bytes = chunk.data.size();
+                BatchItems items;
+                items.emplace_back(next++, std::move(chunk));
+                while (items.size() < maxBatchChunks_) {
+                    FileChunk more;
+                    if (!pull(more)) {
+                        break;
+                    }
+                    if (bytes + more.data.size() > maxBatchBytes_) {
+                        lookahead = std::move(more);
+                        haveLookahead = true;
+                        break;
+                    }
+                    bytes += more.data.size();
+                    items.emplace_back(next++, std::move(more));
+                }
+                startBatch(std::move(items), workerIndex, operation, key, iv);
+            } else {
+                startAttempt(std::move(chunk), next++, workerIndex, operation, key, iv);
+            }
+        }
+        // Streams to draining workers are closed once their queue is written
+        for (auto& stream : streams_) {
+            if (stream) {
+                pumpStream(*stream, exhausted() || retiring(stream->workerIndex));
+            }
+        }
+    };
+
+    size_t hedgesSent = 0;
+    size_t hedgesWon = 0;
+    size_t retriesSent = 0;
+    bool countFailures = true;  // Cleared while settling the rest of a failed batch
+
+    // Transport failures feed the circuit breaker; a worker it takes out of
+    // rotation is probed until it answers again
+    auto noteFailure = [&](size_t workerIndex, bool transport) {
+        if (!countFailures) {
+            return;
+        }
+        if (scheduler.recordFailure(workerIndex, transport)) {
+            std::cerr << "Worker " << workerIndex << " taken out of rotation after repeated failures" << std::endl;
+            probeDue_[workerIndex] = WorkerScheduler::Clock::now() + probeDelay_[workerIndex];
+        }
+    };
+
+    // Settles a chunk with the first successful attempt. When its last
+    // outstanding attempt fails, the chunk is queued for a retry, or handed to
+    // onFailure once its retries are used up. Returns true if this result was
+    // used; results for chunks that are already settled are dropped.
+    // Results decoded by ChunkWire arrive in output; the others in the response.
+    auto handleResult = [&](size_t index, size_t workerIndex, FileChunk& input,
+                            const grpc::Status& status, encryption::ChunkResponse& response,
+                            std::vector<char>* output, PendingCall* call,
+                            WorkerScheduler::Clock::time_point sentAt) {
+        auto it = active_.find(index);
+        if (it == active_.end()) {
+            return false;
+        }
+        ChunkState& state = it->second;
+        if (call) {
+            state.calls.erase(std::remove(state.calls.begin(), state.calls.end(), call), state.calls.end());
+        }
+
+        bool success = status.ok() && response.success();
+        if (!success) {
+            noteFailure(workerIndex, !status.ok());
+        }
+        if (!success && state.attempts > 1) {
+            // Another attempt is still running; let it decide the outcome
+            --state.attempts;
+            state.input = nullptr;
+            std::cerr << "Worker " << workerIndex << " failed chunk " << index
+                      << ", waiting for its other attempt" << std::endl;
+            return false;
+        }
+        if (!success && state.retries < maxRetries_) {
+            auto backoff = std::min<std::chrono::milliseconds>(retryBackoff_ * (1LL << std::min<size_t>(state.retries, 16)),
+                                                               kMaxRetryBackoff);
+            ++state.retries;
+            state.attempts = 0;
+            state.input = nullptr;
+            state.hedged = false;
+            std::cerr << "Worker " << workerIndex << " failed chunk " << index << " ("
+                      << (status.ok() ? response.error_message() : status.error_message())
+                      << "), retry " << state.retries << " of " << maxRetries_
+                      << " in " << backoff.count() << " ms" << std::endl;
+            retries_.emplace(WorkerScheduler::Clock::now() + backoff, RetryItem{index, std::move(input), workerIndex});
+            ++retriesSent;
+            return false;
+        }
+
+        // First result wins; cancel any other attempt that can be cancelled
+        for (PendingCall* other : state.calls) {
+            other->context.TryCancel();
+        }
+        if (success && call && call->hedge) {
+            ++hedgesWon;
+        }
+        size_t retries = state.retries;
+        size_t reservations = state.reservations;
+        active_.erase(it);
+
+        if (success) {
+            latencySamples_.push_back(std::chrono::duration<double, std::milli>(
+                WorkerScheduler::Clock::now() - sentAt).count());
+            if (latencySamples_.size() > kMaxLatencySamples) {
+                latencySamples_.pop_front();
+            }
+
+            FileChunk result;
+            result.id = response.chunk_id();
+            if (sharedStorage()) {
+                // The worker has already written it; only its size comes back
+                result.length = static_cast<size_t>(response.output_length());
+                result.outputOffset = input.outputOffset;
+            } else if (output) {
+                result.data = std::move(*output);
+            } else {
+                result.data.assign(response.processed_data().begin(), response.processed_data().end());
+            }
+            onComplete(index, std::move(result));
+            releaseBudget(reservations);
+            return true;
+        } else {
+            std::string message = "Worker " + std::to_string(workerIndex) +
+                                  " failed to " + opName + " chunk " + std::to_string(index);
+            if (!status.ok()) {
+                message += ", gRPC status: " + status.error_message();
+                message += ", Error code: " + std::to_string(status.error_code());
+            } else {
+                message += ", Response message: " + response.error_message();
+            }
+            if (retries > 0) {
+                message += " (after " + std::to_string(retries) + " retries)";
+            }
+            onFailure(index, input, message);
+            releaseBudget(reservations);
+            return false;
+        }
+    };
+
+    // Sends a second copy of any chunk that has been outstanding for longer
+    // than the hedge percentile to a worker with nothing in flight
+    auto hedgeStragglers = [&]() {
+        if (hedgePercentile_ <= 0 || latencySamples_.size() < kMinHedgeSamples) {
+            return;
+        }
+        double thresholdMs = hedgeThresholdMs();
+        auto now = WorkerScheduler::Clock::now();
+        for (auto& entry : active_) {
+            ChunkState& state = entry.second;
+            double ageMs = std::chrono::duration<double, std::milli>(now - state.sentAt).count();
+            if (state.hedged || !state.input || ageMs < thresholdMs) {
+                continue;
+            }
+
+            // Only idle workers take hedges, so they never delay first attempts
+            std::vector<size_t> load = inFlight_;
+            load[state.workerIndex] = 1;
+            for (size_t i = 0; i < capacity_.size(); ++i) {
+                if (capacity_[i] == 0) {
+                    load[i] = 1;
+                }
+            }
+            size_t target = scheduler.pick(load, 1);
+            if (target >= workerCount()) {
+                return;
+            }
+
+            // The copy for the hedge needs its own share of the memory budget
+            if (!reserveBudget()) {
+                return;
+            }
+            ++state.reservations;
+
+            std::cout << "Chunk " << entry.first << " outstanding for " << static_cast<long>(ageMs)
+                      << " ms on worker " << state.workerIndex << " (p" << hedgePercentile_ << " is "
+                      << static_cast<long>(thresholdMs) << " ms), hedging on worker " << target << std::endl;
+            state.hedged = true;
+            startAttempt(FileChunk(*state.input), entry.first, target, operation, key, iv);
+            ++hedgesSent;
+        }
+    };
+
+    // A stream is done once Finish has returned and none of its operations are queued
+    auto streamsActive = [&]() {
+        for (auto& stream : streams_) {
+            if (stream && (!stream->finished || stream->opsPending > 0)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto handleStreamEvent = [&](StreamTag* tag, bool ok) {
+        WorkerStream& stream = *tag->stream;
+        --stream.opsPending;
+
+        switch (tag->kind) {
+            case Tag::Kind::StreamStart:
+                if (ok) {
+                    stream.started = true;
+                    stream.stream->Read(&stream.reply, &stream.readTag);
+                    ++stream.opsPending;
+                } else {
+                    // No read was posted, so there is nothing left to receive
+                    stream.started = true;
+                    stream.readClosed = true;
+                }
+                break;
+
+            case Tag::Kind::StreamWrite:
+                stream.writing = false;
+                if (ok) {
+                    stream.writeQueue.pop_front();
+                } else {
+                    // The stream is broken; stop writing and let the failed read end it
+                    stream.writesDone = true;
+                }
+                break;
+
+            case Tag::Kind::StreamRead: {
+                if (!ok) {
+                    stream.readClosed = true;
+                    break;
+                }
+                // The previous frame is done with by now
+                responseFrames_.reset();
+                encryption::ChunkResponse& response = *responseFrames_.create<encryption::ChunkResponse>();
+                std::vector<char> output;
+                bool decoded = ChunkWire::decodeResponse(stream.reply, response, output);
+                stream.reply.Clear();
+                stream.stream->Read(&stream.reply, &stream.readTag);
+                ++stream.opsPending;
+                if (!decoded) {
+                    std::cerr << "Worker " << stream.workerIndex << " sent a malformed stream frame" << std::endl;
+                    break;
+                }
+                bytesCopied_ += output.size();
+
+                auto it = stream.pending.find(response.request_id());
+                if (it == stream.pending.end()) {
+                    std::cerr << "Worker " << stream.workerIndex << " returned unknown request "
+                              << response.request_id() << std::endl;
+                    break;
+                }
+                StreamedChunk chunk = std::move(it->second);
+                stream.pending.erase(it);
+                --inFlight_[stream.workerIndex];
+                if (handleResult(static_cast<size_t>(response.request_id()), stream.workerIndex,
+                                 chunk.input, grpc::Status::OK, response, &output, nullptr, chunk.sentAt)) {
+                    scheduler.recordCompletion(stream.workerIndex, chunk.input.byteCount(), 1, chunk.sentAt);
+                }
+                break;
+            }
+
+            case Tag::Kind::StreamWritesDone:
+                break;
+
+            case Tag::Kind::StreamFinish: {
+                stream.finished = true;
+                size_t workerIndex = stream.workerIndex;
+                bool unimplemented = stream.status.error_code() == grpc::StatusCode::UNIMPLEMENTED;
+                if (unimplemented) {
+                    std::cout << "Worker " << workerIndex << " does not support streaming, using unary calls" << std::endl;
+                } else if (!stream.status.ok()) {
+                    std::cerr << "Stream to worker " << workerIndex << " failed: "
+                              << stream.status.error_message() << std::endl;
+                }
+
+                // Whatever is still pending never got a result
+                std::vector<std::pair<size_t, StreamedChunk>> leftover(std::make_move_iterator(stream.pending.begin()),
+                                                                       std::make_move_iterator(stream.pending.end()));
+                stream.pending.clear();
+                stream.writeQueue.clear();
+                std::sort(leftover.begin(), leftover.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
+
+                // Later chunks for this worker go out as unary calls
+                for (auto& item : leftover) {
+                    --inFlight_[workerIndex];
+                    if (unimplemented && active_.count(item.first)) {
+                        dropAttempt(item.first);
+                        startCall(std::move(item.second.input), item.first, workerIndex, operation, key, iv);
+                    } else {
+                        encryption::ChunkResponse empty;
+                        grpc::Status status = stream.status.ok()
+                            ? grpc::Status(grpc::StatusCode::UNAVAILABLE, "stream closed before the chunk completed")
+                            : stream.status;
+                        handleResult(item.first, workerIndex, item.second.input, status, empty,
+                                     nullptr, nullptr, item.second.sentAt);
+                    }
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    };
+
+    auto handleBatch = [&](PendingBatch& batch, bool ok) {
+        size_t workerIndex = batch.workerIndex;
+        --inFlight_[workerIndex];
+        grpc::Status status = ok ? batch.status
+                                 : grpc::Status(grpc::StatusCode::CANCELLED, "call did not complete");
+
+        if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED) {
+            // Older worker: send these chunks, and any later ones, one per call
+            std::cout << "Worker " << workerIndex << " does not support batches, using single-chunk calls" << std::endl;
+            batchUnsupported_[workerIndex] = true;
+            for (auto& item : batch.items) {
+                if (active_.count(item.first)) {
+                    dropAttempt(item.first);
+                    startCall(std::move(item.second), item.first, workerIndex, operation, key, iv);
+                }
+            }
+            return;
+        }
+
+        // The batch counts as a single request for throughput
+        uint64_t bytes = 0;
+        size_t succeeded = 0;
+        for (size_t i = 0; i < batch.items.size(); ++i) {
+            auto& item = batch.items[i];
+            size_t inputSize = item.second.byteCount();
+            bool ok = false;
+            if (!status.ok()) {
+                // One failed call, so it counts once against the worker
+                countFailures = i == 0;
+                encryption::ChunkResponse empty;
+                ok = handleResult(item.first, workerIndex, item.second, status, empty, nullptr, nullptr, batch.sentAt);
+                countFailures = true;
+            } else if (i < static_cast<size_t>(batch.response->results_size())) {
+                encryption::ChunkResponse& result = *batch.response->mutable_results(static_cast<int>(i));
+                bytesMoved_ += result.processed_data().size();
+                bytesCopied_ += 2 * result.processed_data().size();  // Parsed, then copied out
+                ok = handleResult(item.first, workerIndex, item.second, status, result, nullptr, nullptr, batch.sentAt);
+            } else {
+                encryption::ChunkResponse missing;
+                missing.set_error_message("batch response has no result for this chunk");
+                ok = handleResult(item.first, workerIndex, item.second, status, missing, nullptr, nullptr, batch.sentAt);
+            }
+            if (ok) {
+                bytes += inputSize;
+                ++succeeded;
+            }
+        }
+        if (succeeded > 0) {
+            scheduler.recordCompletion(workerIndex, bytes, succeeded, batch.sentAt);
+        }
+    };
+
+    // A probed worker that answers goes back into rotation with unary calls
+    // and inline keys, since it may have restarted and lost its session
+    auto handleProbe = [&](PendingProbe& probe, bool ok) {
+        size_t workerIndex = probe.workerIndex;
+        if (ok && probe.status.ok() && probe.response.alive()) {
+            std::cout << "Worker " << workerIndex << " answered TestConnection, returning it to rotation" << std::endl;
+            scheduler.markAvailable(workerIndex);
+            probeDelay_[workerIndex] = kProbeDelay;
+            sessions_[workerIndex] = 0;
+            batchUnsupported_[workerIndex] = false;
+        } else {
+            probeDelay_[workerIndex] = std::min(probeDelay_[workerIndex] * 2, kMaxProbeDelay);
+            probeDue_[workerIndex] = WorkerScheduler::Clock::now() + probeDelay_[workerIndex];
+        }
+    };
+
+    // Timed work: due probes, stragglers to hedge and giving up on a job that
+    // has had no worker in rotation for too long
+    WorkerScheduler::Clock::time_point outageSince = WorkerScheduler::Clock::time_point::max();
+    auto runTimers = [&]() {
+        if (cancelled_ && cancelled_->load()) {
+            throw std::runtime_error("Job cancelled");
+        }
+        if (membership_) {
+            syncMembership();
+        }
+        auto now = WorkerScheduler::Clock::now();
+        for (size_t i = 0; i < probeDue_.size(); ++i) {
+            if (probeDue_[i] <= now) {
+                startProbe(i);
+            }
+        }
+        if (scheduler.availableCount() > 0) {
+            outageSince = WorkerScheduler::Clock::time_point::max();
+        } else if (outageSince == WorkerScheduler::Clock::time_point::max()) {
+            std::cerr << "No workers in rotation, waiting for one to come back" << std::endl;
+            outageSince = now;
+        } else if (now - outageSince > kMaxOutage) {
+            throw std::runtime_error("No worker has been reachable for " +
+                                     std::to_string(kMaxOutage.count()) + " seconds");
+        }
+        hedgeStragglers();
+    };
+
+    // Next time something timed is due, or max() if only completions matter
+    auto nextWakeup = [&]() {
+        auto wakeup = WorkerScheduler::Clock::time_point::max();
+        if (hedgePercentile_ > 0) {
+            wakeup = WorkerScheduler::Clock::now() + kHedgePollInterval;
+        }
+        if (!retries_.empty()) {
+            wakeup = std::min(wakeup, retries_.begin()->first);
+        }
+        for (const auto& due : probeDue_) {
+            wakeup = std::min(wakeup, due);
+        }
+        if (outageSince != WorkerScheduler::Clock::time_point::max()) {
+            wakeup = std::min(wakeup, outageSince + kMaxOutage);
+        }
+        if (budgetStalled) {
+            // The budget may be freed by another job, which posts nothing here
+            wakeup = std::min(wakeup, WorkerScheduler::Clock::now() + kBudgetPollInterval);
+        }
+        if (cancelled_) {
+            wakeup = std::min(wakeup, WorkerScheduler::Clock::now() + kCancelPollInterval);
+        }
+        if (membership_) {
+            wakeup = std::min(wakeup, WorkerScheduler::Clock::now() + kMembershipPollInterval);
+        }
+        return wakeup;
+    };
+
+    std::exception_ptr error;
+    try {
+        runTimers();
+        fillWindows();
+
+        // Work remains while anything is outstanding, waiting to be retried or
+        // still in the source; unavailable workers are being probed meanwhile
+        void* tag = nullptr;
+        bool ok = false;
+        while (!outstanding_.empty() || !outstandingBatches_.empty() || !localOutstanding_.empty() ||
+               streamsActive() || !retries_.empty() || !exhausted()) {
+            auto wakeup = nextWakeup();
+            if (wakeup == WorkerScheduler::Clock::time_point::max()) {
+                if (!cq_->Next(&tag, &ok)) {
+                    break;
+                }
+            } else {
+                auto deadline = std::chrono::system_clock::now() +
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::max(wakeup - WorkerScheduler::Clock::now(), WorkerScheduler::Clock::duration::zero()));
+                auto status = cq_->AsyncNext(&tag, &ok, deadline);
+                if (status == grpc::CompletionQueue::SHUTDOWN) {
+                    break;
+                }
+                if (status == grpc::CompletionQueue::TIMEOUT) {
+                    runTimers();
+                    fillWindows();
+                    continue;
+                }
+            }
+
+            Tag* base = static_cast<Tag*>(tag);
+            if (base->kind == Tag::Kind::Call) {
+                std::unique_ptr<PendingCall> call(static_cast<PendingCall*>(base));
+                outstanding_.erase(call.get());
+                grpc::Status status = ok ? call->status
+                                         : grpc::Status(grpc::StatusCode::CANCELLED, "call did not complete");
+                if (status.ok() && !ChunkWire::decodeResponse(call->reply, *call->response, call->output)) {
+                    status = grpc::Status(grpc::StatusCode::INTERNAL, "malformed response");
+                }
+                if (call->ring) {
+                    finishRingCall(*call, status);
+                }
+                bytesMoved_ += call->output.size();
+                bytesCopied_ += call->output.size();
+                --inFlight_[call->workerIndex];
+                size_t inputSize = call->input.byteCount();
+                if (handleResult(call->index, call->workerIndex, call->input, status, *call->response,
+                                 &call->output, call.get(), call->sentAt)) {
+                    scheduler.recordCompletion(call->workerIndex, inputSize, 1, call->sentAt);
+                }
+            } else if (base->kind == Tag::Kind::Batch) {
+                std::unique_ptr<PendingBatch> batch(static_cast<PendingBatch*>(base));
+                outstandingBatches_.erase(batch.get());
+                handleBatch(*batch, ok);
+            } else if (base->kind == Tag::Kind::Probe) {
+                std::unique_ptr<PendingProbe> probe(static_cast<PendingProbe*>(base));
+                probes_.erase(probe.get());
+                handleProbe(*probe, ok);
+            } else if (base->kind == Tag::Kind::Local) {
+                std::unique_ptr<PendingLocal> local(static_cast<PendingLocal*>(base));
+                localOutstanding_.erase(local.get());
+                --inFlight_[local->workerIndex];
+                size_t inputSize = local->input.byteCount();
+                bytesMoved_ += inputSize + local->response.processed_data().size();
+                bytesCopied_ += local->response.processed_data().size();
+                if (handleResult(local->index, local->workerIndex, local->input, grpc::Status::OK,
+                                 local->response, nullptr, nullptr, local->sentAt)) {
+                    scheduler.recordCompletion(local->workerIndex, inputSize, 1, local->sentAt);
+                }
+            } else {
+                handleStreamEvent(static_cast<StreamTag*>(base), ok);
+            }
+
+            runTimers();
+            fillWindows();
+        }
+
+        // Probes still running are of no use to a finished job
+        for (PendingProbe* probe : probes_) {
+            probe->context.TryCancel();
+        }
+    } catch (...) {
+        error = std::current_exception();
+        cancelOutstanding();
+    }
+
+    // Drain whatever is still queued so no tag outlives the completion queue
+    auto reclaim = [&](void* tag) {
+        Tag* base = static_cast<Tag*>(tag);
+        if (base->kind == Tag::Kind::Call) {
+            auto* call = static_cast<PendingCall*>(base);
+            outstanding_.erase(call);
+            delete call;
+        } else if (base->kind == Tag::Kind::Batch) {
+            auto* batch = static_cast<PendingBatch*>(base);
+            outstandingBatches_.erase(batch);
+            delete batch;
+        } else if (base->kind == Tag::Kind::Probe) {
+            auto* probe = static_cast<PendingProbe*>(base);
+            probes_.erase(probe);
+            delete probe;
+        } else if (base->kind == Tag::Kind::Local) {
+            auto* local = static_cast<PendingLocal*>(base);
+            localOutstanding_.erase(local);
+            delete local;
+        }
+    };
+    void* tag = nullptr;
+    bool ok = false;
+
+    // Local tasks cannot be cancelled, and their alarms must not be set on a
+    // queue that is shutting down, so wait for them first
+    while (!localOutstanding_.empty() && cq_->Next(&tag, &ok)) {
+        reclaim(tag);
+    }
+    cq_->Shutdown();
+    while (cq_->Next(&tag, &ok)) {
+        reclaim(tag);
+    }
+    streams_.clear();
+    cq_.reset();
+    requestFrames_.reset();
+    responseFrames_.reset();
+    active_.clear();
+    retries_.clear();
+    releaseBudget(reservedChunks_);
+    auto teardownDeadline = std::chrono::system_clock::now() + kControlTimeout;
+    closeSessions(teardownDeadline);
+    detachRings(teardownDeadline);
+
+    std::cout << "Dispatched " << next << " chunks" << std::endl;
+    if (next > 0 && bytesMoved_ > 0) {
+        // Chunk bytes copied in memory on this side, excluding file reads and writes
+        std::cout << "Copied " << bytesCopied_ / next << " bytes of chunk data per chunk ("
+                  << std::fixed << std::setprecision(2) << static_cast<double>(bytesCopied_) / bytesMoved_
+                  << std::defaultfloat << " copies per byte sent or received)" << std::endl;
+    }
+    std::cout << arenaStats_.summary(next);
+    if (budgetStalls > 0) {
+        std::cout << "Reading stalled " << budgetStalls << " times on the memory budget" << std::endl;
+    }
+    if (localPool_) {
+        std::cout << "Local pool threads have stolen " << localPool_->steals() << " tasks so far" << std::endl;
+    }
+    if (retriesSent > 0) {
+        std::cout << "Retried " << retriesSent << " failed chunk attempts" << std::endl;
+    }
+    if (hedgesSent > 0) {
+        std::cout << "Hedged " << hedgesSent << " chunks, " << hedgesWon << " hedges finished first" << std::endl;
+    }
+    std::cout << scheduler.summary();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
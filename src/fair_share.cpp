@@ -0,0 +1,38 @@
+#include "fair_share.h"
+#include <algorithm>
+
+size_t FairShare::join(double weight) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    weight = std::max(weight, 1e-3);
+    size_t id = nextId_++;
+    weights_[id] = weight;
+    totalWeight_ += weight;
+    return id;
+}
+
+void FairShare::leave(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = weights_.find(id);
+    if (it == weights_.end()) {
+        return;
+    }
+    totalWeight_ -= it->second;
+    weights_.erase(it);
+    if (weights_.empty()) {
+        totalWeight_ = 0;  // Drop accumulated rounding error
+    }
+}
+
+double FairShare::fraction(size_t id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = weights_.find(id);
+    if (it == weights_.end() || totalWeight_ <= 0) {
+        return 1.0;
+    }
+    return std::min(1.0, it->second / totalWeight_);
+}
+
+size_t FairShare::activeCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return weights_.size();
+}
@@ -0,0 +1,393 @@
+#include "job_queue.h"
+#include "crypto.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+// Same layout as the CLI's encryption_key.bin: the key followed by the IV
+static void writeKeyFile(const std::string& path, const std::string& key, const std::string& iv) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open key file for writing: " + path);
+    }
+    file.write(key.data(), key.size());
+    file.write(iv.data(), iv.size());
+    if (!file) {
+        throw std::runtime_error("Failed to write key file: " + path);
+    }
+}
+
+static void readKeyFile(const std::string& path, std::string& key, std::string& iv) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not find encryption key file: " + path);
+    }
+    key.resize(32);
+    iv.resize(16);
+    file.read(&key[0], key.size());
+    file.read(&iv[0], iv.size());
+    if (file.fail()) {
+        throw std::runtime_error("Error reading encryption key file: " + path);
+    }
+}
+
+static const char* stateName(JobState state) {
+    switch (state) {
+        case JobState::Queued: return "queued";
+        case JobState::Running: return "running";
+        case JobState::Succeeded: return "succeeded";
+        case JobState::Failed: return "failed";
+        case JobState::Cancelled: return "cancelled";
+    }
+    return "unknown";
+}
+
+JobQueue::JobQueue(EncryptionMaster& master, size_t maxRunning, size_t chunkSize)
+    : master_(master), chunkSize_(chunkSize) {
+    maxRunning = std::max<size_t>(1, maxRunning);
+    runners_.reserve(maxRunning);
+    for (size_t i = 0; i < maxRunning; ++i) {
+        runners_.emplace_back(&JobQueue::runLoop, this);
+    }
+}
+
+JobQueue::~JobQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& entry : jobs_) {
+            Job& job = *entry.second;
+            if (job.state == JobState::Queued) {
+                job.state = JobState::Cancelled;
+                job.finishedAt = Clock::now();
+            } else if (job.state == JobState::Running) {
+                job.control.cancelled = true;
+            }
+        }
+        queued_.clear();
+    }
+    ready_.notify_all();
+    for (auto& runner : runners_) {
+        runner.join();
+    }
+}
+
+// Weights of the priority classes while running
+double JobQueue::weight(JobPriority priority) {
+    switch (priority) {
+        case JobPriority::Low: return 1.0;
+        case JobPriority::High: return 4.0;
+        default: return 2.0;
+    }
+}
+
+uint64_t JobQueue::submit(const JobSpec& spec) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = nextId_++;
+        auto job = std::make_shared<Job>();
+        job->id = id;
+        job->spec = spec;
+        job->submittedAt = Clock::now();
+        jobs_[id] = job;
+        queued_.emplace(-static_cast<int>(spec.priority), id);
+    }
+    std::cout << "Job " << id << " queued: " << (spec.operation == ChunkOperation::Encrypt ? "encrypt " : "decrypt ")
+              << spec.inputPath << " -> " << spec.outputPath << std::endl;
+    ready_.notify_one();
+    return id;
+}
+
+bool JobQueue::status(uint64_t id, JobInfo& info) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return false;
+    }
+    info = describe(*it->second);
+    return true;
+}
+
+bool JobQueue::cancel(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return false;
+    }
+    Job& job = *it->second;
+    if (job.state == JobState::Queued) {
+        queued_.erase(std::make_pair(-static_cast<int>(job.spec.priority), id));
+        job.state = JobState::Cancelled;
+        job.finishedAt = Clock::now();
+        std::cout << "Job " << id << " cancelled before it started" << std::endl;
+        return true;
+    }
+    if (job.state == JobState::Running && !job.control.cancelled) {
+        job.control.cancelled = true;
+        std::cout << "Cancelling job " << id << std::endl;
+        return true;
+    }
+    return false;
+}
+
+std::vector<JobInfo> JobQueue::list() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<JobInfo> infos;
+    infos.reserve(jobs_.size());
+    for (const auto& entry : jobs_) {
+        infos.push_back(describe(*entry.second));
+    }
+    return infos;
+}
+
+JobInfo JobQueue::describe(const Job& job) const {
+    JobInfo info;
+    info.id = job.id;
+    info.spec = job.spec;
+    info.state = job.state;
+    info.chunksDone = job.control.chunksDone;
+    info.chunksTotal = job.control.chunksTotal;
+    info.error = job.error;
+
+    auto now = Clock::now();
+    auto started = job.state == JobState::Queued ? now : job.startedAt;
+    if (job.state == JobState::Cancelled && job.startedAt == Clock::time_point()) {
+        started = job.finishedAt;  // Cancelled while queued
+    }
+    info.queued = std::chrono::duration_cast<std::chrono::milliseconds>(started - job.submittedAt);
+    if (job.startedAt != Clock::time_point()) {
+        auto ended = job.state == JobState::Running ? now : job.finishedAt;
+        info.running = std::chrono::duration_cast<std::chrono::milliseconds>(ended - job.startedAt);
+    }
+    return info;
+}
+
+// Drops the oldest finished records beyond kMaxFinishedJobs; called with mutex_ held
+void JobQueue::forgetFinished() {
+    size_t finished = 0;
+    for (const auto& entry : jobs_) {
+        JobState state = entry.second->state;
+        if (state != JobState::Queued && state != JobState::Running) {
+            ++finished;
+        }
+    }
+    for (auto it = jobs_.begin(); it != jobs_.end() && finished > kMaxFinishedJobs;) {
+        JobState state = it->second->state;
+        if (state != JobState::Queued && state != JobState::Running) {
+            it = jobs_.erase(it);
+            --finished;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void JobQueue::runLoop() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !queued_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = jobs_[queued_.begin()->second];
+            queued_.erase(queued_.begin());
+            job->state = JobState::Running;
+            job->startedAt = Clock::now();
+            job->control.shares = &shares_;
+            job->control.shareId = shares_.join(weight(job->spec.priority));
+        }
+
+        runJob(*job);
+        shares_.leave(job->control.shareId);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        forgetFinished();
+    }
+}
+
+void JobQueue::runJob(Job& job) {
+    const JobSpec& spec = job.spec;
+    bool encrypt = spec.operation == ChunkOperation::Encrypt;
+    std::string keyPath = spec.keyPath;
+    if (keyPath.empty()) {
+        keyPath = (encrypt ? spec.outputPath : spec.inputPath) + ".key";
+    }
+    std::cout << "Job " << job.id << " started with " << shares_.activeCount() << " job(s) running" << std::endl;
+
+    JobState state = JobState::Failed;
+    std::string error;
+    bool keyWritten = false;
+    try {
+        std::string key, iv;
+        if (encrypt) {
+            AESCrypto::generateKeyIV(key, iv);
+            writeKeyFile(keyPath, key, iv);
+            keyWritten = true;
+        } else {
+            readKeyFile(keyPath, key, iv);
+        }
+        bool ok = encrypt
+            ? master_.encryptFileTo(spec.inputPath, spec.outputPath, chunkSize_, key, iv, &job.control)
+            : master_.decryptFileTo(spec.inputPath, spec.outputPath, chunkSize_, key, iv, &job.control);
+        if (ok) {
+            state = JobState::Succeeded;
+        } else if (job.control.cancelled) {
+            state = JobState::Cancelled;
+        } else {
+            error = "Failed to finalize output file " + spec.outputPath;
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+        if (job.control.cancelled) {
+            state = JobState::Cancelled;
+        }
+    }
+
+    if (state != JobState::Succeeded) {
+        // A partial output file would look like a finished one to the user
+        std::error_code ec;
+        std::filesystem::remove(spec.outputPath, ec);
+        // The key this job generated is of no use without the output
+        if (keyWritten) {
+            std::filesystem::remove(keyPath, ec);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    job.state = state;
+    job.error = error;
+    job.finishedAt = Clock::now();
+    std::cout << "Job " << job.id << " " << stateName(state)
+              << (error.empty() ? "" : ": " + error) << std::endl;
+}
+
+static JobPriority fromProto(encryption::JobPriority priority) {
+    switch (priority) {
+        case encryption::JOB_PRIORITY_LOW: return JobPriority::Low;
+        case encryption::JOB_PRIORITY_HIGH: return JobPriority::High;
+        default: return JobPriority::Normal;
+    }
+}
+
+static encryption::JobPriority toProto(JobPriority priority) {
+    switch (priority) {
+        case JobPriority::Low: return encryption::JOB_PRIORITY_LOW;
+        case JobPriority::High: return encryption::JOB_PRIORITY_HIGH;
+        default: return encryption::JOB_PRIORITY_NORMAL;
+    }
+}
+
+static encryption::JobState toProto(JobState state) {
+    switch (state) {
+        case JobState::Running: return encryption::JOB_RUNNING;
+        case JobState::Succeeded: return encryption::JOB_SUCCEEDED;
+        case JobState::Failed: return encryption::JOB_FAILED;
+        case JobState::Cancelled: return encryption::JOB_CANCELLED;
+        default: return encryption::JOB_QUEUED;
+    }
+}
+
+static void fillStatus(const JobInfo& info, encryption::JobStatus* status) {
+    status->set_found(true);
+    status->set_job_id(info.id);
+    status->set_state(toProto(info.state));
+    status->set_priority(toProto(info.spec.priority));
+    status->set_operation(info.spec.operation == ChunkOperation::Encrypt ? encryption::OPERATION_ENCRYPT
+                                                                         : encryption::OPERATION_DECRYPT);
+    status->set_input_path(info.spec.inputPath);
+    status->set_output_path(info.spec.outputPath);
+    status->set_chunks_done(info.chunksDone);
+    status->set_chunks_total(info.chunksTotal);
+    status->set_error_message(info.error);
+    status->set_queued_ms(info.queued.count());
+    status->set_running_ms(info.running.count());
+}
+
+grpc::Status MasterControlService::SubmitJob(grpc::ServerContext* context,
+                                             const encryption::SubmitJobRequest* request,
+                                             encryption::SubmitJobResponse* response) {
+    if (request->input_path().empty() || request->output_path().empty()) {
+        response->set_accepted(false);
+        response->set_error_message("Input and output paths are required");
+        return grpc::Status::OK;
+    }
+    std::error_code ec;
+    if (!std::filesystem::exists(request->input_path(), ec)) {
+        response->set_accepted(false);
+        response->set_error_message("Input file not found: " + request->input_path());
+        return grpc::Status::OK;
+    }
+
+    JobSpec spec;
+    spec.operation = request->operation() == encryption::OPERATION_DECRYPT ? ChunkOperation::Decrypt
+                                                                           : ChunkOperation::Encrypt;
+    spec.inputPath = request->input_path();
+    spec.outputPath = request->output_path();
+    spec.keyPath = request->key_path();
+    spec.priority = fromProto(request->priority());
+
+    response->set_accepted(true);
+    response->set_job_id(jobs_.submit(spec));
+    return grpc::Status::OK;
+}
+
+grpc::Status MasterControlService::GetJobStatus(grpc::ServerContext* context,
+                                                const encryption::JobStatusRequest* request,
+                                                encryption::JobStatus* response) {
+    JobInfo info;
+    if (!jobs_.status(request->job_id(), info)) {
+        response->set_found(false);
+        response->set_job_id(request->job_id());
+        return grpc::Status::OK;
+    }
+    fillStatus(info, response);
+    return grpc::Status::OK;
+}
+
+grpc::Status MasterControlService::CancelJob(grpc::ServerContext* context,
+                                             const encryption::CancelJobRequest* request,
+                                             encryption::CancelJobResponse* response) {
+    response->set_success(jobs_.cancel(request->job_id()));
+    return grpc::Status::OK;
+}
+
+grpc::Status MasterControlService::ListJobs(grpc::ServerContext* context,
+                                            const encryption::ListJobsRequest* request,
+                                            encryption::ListJobsResponse* response) {
+    for (const JobInfo& info : jobs_.list()) {
+        fillStatus(info, response->add_jobs());
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status WorkerRegistryService::RegisterWorker(grpc::ServerContext* context,
+                                                   const encryption::RegisterWorkerRequest* request,
+                                                   encryption::RegisterWorkerResponse* response) {
+    if (request->address().empty()) {
+        response->set_accepted(false);
+        response->set_error_message("Worker address is required");
+        return grpc::Status::OK;
+    }
+    members_.registerWorker(request->address(), request->capacity());
+    response->set_accepted(true);
+    response->set_heartbeat_interval_ms(static_cast<uint32_t>(members_.heartbeatInterval().count()));
+    return grpc::Status::OK;
+}
+
+grpc::Status WorkerRegistryService::Heartbeat(grpc::ServerContext* context,
+                                              const encryption::HeartbeatRequest* request,
+                                              encryption::HeartbeatResponse* response) {
+    response->set_known(members_.heartbeat(request->address(), request->queue_depth(), request->capacity()));
+    return grpc::Status::OK;
+}
+
+grpc::Status WorkerRegistryService::DeregisterWorker(grpc::ServerContext* context,
+                                                     const encryption::DeregisterWorkerRequest* request,
+                                                     encryption::DeregisterWorkerResponse* response) {
+    response->set_success(members_.drain(request->address()));
+    return grpc::Status::OK;
+}
@@ -0,0 +1,140 @@
+#include "local_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+// Pool and deque of the calling thread, if it is a pool thread
+static thread_local const LocalCryptoPool* currentPool = nullptr;
+static thread_local size_t currentQueue = 0;
+
+LocalCryptoPool::LocalCryptoPool(size_t threads, bool pinThreads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&LocalCryptoPool::run, this, i, pinThreads);
+    }
+}
+
+LocalCryptoPool::~LocalCryptoPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void LocalCryptoPool::submit(Task task) {
+    size_t target = currentPool == this ? currentQueue : nextQueue_++ % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++unclaimed_;
+    }
+    ready_.notify_one();
+}
+
+// Own deque first (oldest task), then the newest task of the other threads
+bool LocalCryptoPool::take(size_t self, Task& task) {
+    {
+        Queue& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        Queue& victim = *queues_[(self + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            ++steals_;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Queued tasks still run on shutdown, so whoever submitted them gets its results
+void LocalCryptoPool::run(size_t self, bool pin) {
+    currentPool = this;
+    currentQueue = self;
+    if (pin) {
+        size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        size_t core = self % std::min<size_t>(cores, sizeof(DWORD_PTR) * 8);
+        if (!SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core)) {
+            std::cerr << "Could not pin crypto thread " << self << " to core " << core << std::endl;
+        }
+    }
+    for (;;) {
+        {
+            // Claim one task before looking for it, so a claimed task is
+            // always sitting in some deque
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || unclaimed_ > 0; });
+            if (unclaimed_ == 0) {
+                return;
+            }
+            --unclaimed_;
+        }
+        Task task;
+        while (!take(self, task)) {
+            std::this_thread::yield();
+        }
+        task();
+    }
+}
+
+double LocalCryptoPool::calibratedThroughput(CipherMode mode) {
+    static std::mutex mutex;
+    static std::map<CipherMode, double> measured;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = measured.find(mode);
+    if (it != measured.end()) {
+        return it->second;
+    }
+
+    // A few passes over a 4 MB buffer; the first one also warms up the context cache
+    std::string key;
+    std::string iv;
+    AESCrypto::generateKeyIV(key, iv);
+    if (mode == CipherMode::AES_256_GCM) {
+        iv = AESCrypto::generateNonce();
+    }
+    std::vector<char> input(4 * 1024 * 1024, 'x');
+    std::vector<char> output(AESCrypto::encryptedSize(input.size(), mode));
+    AESCrypto::encrypt(mode, input, output, key, iv, 0);
+
+    const int passes = 4;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; ++i) {
+        AESCrypto::encrypt(mode, input, output, key, iv, static_cast<uint64_t>(i));
+    }
+    double seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+    double throughput = passes * static_cast<double>(input.size()) / seconds;
+
+    std::cout << "Local " << AESCrypto::cipherModeName(mode) << " throughput: "
+              << static_cast<long>(throughput / (1024 * 1024)) << " MB/s per thread" << std::endl;
+    measured[mode] = throughput;
+    return throughput;
+}
@@ -1,5 +1,10 @@
 #include "master.h"
 #include "utilities.h"  // For ReadFile if using TLS
+#include "dispatcher.h"
+#include "crypto.h"
+#include "writer.h"
+#include "container.h"
+#include "shared_ring.h"
 #include <thread>
 #include <future>
 #include <iostream>
@@ -12,32 +17,106 @@
 #include <fstream>  // Added for ofstream
 #include <filesystem> // Added for path operations
 #include <direct.h>  // Added for _getcwd
+#include <cstring>
+#include <limits>
 
 // Constructor implementation
-EncryptionMaster::EncryptionMaster(const std::vector<std::string>& workerAddresses, bool useTLS) 
-    : useTLS_(useTLS) {
-    std::cout << "Initializing EncryptionMaster with " << workerAddresses.size() << " workers" << std::endl;
+EncryptionMaster::EncryptionMaster(const std::vector<std::string>& workerAddresses, bool useTLS,
+                                   size_t connectionsPerWorker)
+    : useTLS_(useTLS),
+      membership_(std::make_shared<WorkerMembership>(useTLS, connectionsPerWorker)) {
+    std::cout << "Initializing EncryptionMaster with " << workerAddresses.size() << " workers, "
+              << std::max<size_t>(1, connectionsPerWorker) << " connection(s) each" << std::endl;
     for (const auto& address : workerAddresses) {
-        std::cout << "Creating channel to worker at " << address << (useTLS_ ? " (TLS)" : " (insecure)") << std::endl;
-        auto channel = createChannel(address);  // Use the channel creation method
-        stubs_.push_back(encryption::EncryptionService::NewStub(channel));
+        membership_->add(address);
     }
-    std::cout << "Created " << stubs_.size() << " worker stubs" << std::endl;
+    scheduler_.resize(membership_->size());
 }
 
-// Channel creation method
-std::shared_ptr<grpc::Channel> EncryptionMaster::createChannel(const std::string& address) {
-    if (useTLS_) {
-        grpc::SslCredentialsOptions ssl_opts;
-        try {
-            ssl_opts.pem_root_certs = ReadFile("ca.crt");
-            return grpc::CreateChannel(address, grpc::SslCredentials(ssl_opts));
-        } catch (const std::exception& e) {
-            std::cerr << "Failed to load TLS credentials: " << e.what() << std::endl;
-            throw;
+void EncryptionMaster::setLocalThreads(size_t threads) {
+    localPool_ = std::make_unique<LocalCryptoPool>(threads);
+    membership_->addLocal();
+    scheduler_.resize(std::max(scheduler_.size(), membership_->size()));
+    std::cout << "Local crypto pool with " << localPool_->threadCount() << " threads" << std::endl;
+}
+
+static uint64_t totalBytes(const std::vector<FileChunk>& chunks) {
+    uint64_t bytes = 0;
+    for (const auto& chunk : chunks) {
+        bytes += chunk.data.size();
+    }
+    return bytes;
+}
+
+// Rough per-file cost model. Remote work pays setup round trips before chunks
+// flow; every worker is set up at once, so the slowest one sets the cost.
+// The work then runs on the workers and the local pool together; local-only
+// work pays just for the crypto. Workers that have neither been measured nor reported a
+// rate are assumed to match the local pool, limited by a typical LAN link.
+bool EncryptionMaster::preferLocal(uint64_t bytes, CipherMode mode) const {
+    if (!localPool_) {
+        return false;
+    }
+    std::vector<WorkerStats> stats = scheduler_.stats();
+    std::vector<WorkerMember> members = membership_->snapshot();
+    size_t localIndex = 0;
+    while (localIndex < members.size() && members[localIndex].pool) {
+        ++localIndex;
+    }
+    double localRate = localIndex < stats.size() && stats[localIndex].chunks > 0
+        ? stats[localIndex].throughput
+        : localPool_->threadCount() * LocalCryptoPool::calibratedThroughput(mode);
+
+    double remoteRate = 0;
+    double slowestRttMs = 0;
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (!members[i].pool || members[i].state != MemberState::Active ||
+            (i < stats.size() && !stats[i].available)) {
+            continue;
         }
-    } else {
-        return grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
+        // Measured, or reported by the worker when it was tested
+        bool known = i < stats.size() && stats[i].throughput > 0;
+        remoteRate += known ? stats[i].throughput : std::min(localRate, kAssumedLinkBytesPerSecond);
+        double rttMs = i < rttMs_.size() && rttMs_[i] > 0 ? rttMs_[i] : kAssumedRttMs;
+        slowestRttMs = std::max(slowestRttMs, rttMs);
+    }
+    double setupSeconds = 2 * slowestRttMs / 1000.0;
+    if (remoteRate <= 0) {
+        return true;
+    }
+
+    double localSeconds = bytes / localRate;
+    double hybridSeconds = setupSeconds + bytes / (remoteRate + localRate);
+    bool local = localSeconds <= hybridSeconds;
+    std::cout << "Cost model for " << bytes << " bytes: local " << static_cast<long>(localSeconds * 1000)
+              << " ms, with workers " << static_cast<long>(hybridSeconds * 1000) << " ms, using "
+              << (local ? "the local pool only" : "workers and the local pool") << std::endl;
+    return local;
+}
+
+void EncryptionMaster::configureDispatcher(ChunkDispatcher& dispatcher, uint64_t bytes,
+                                           size_t chunkSize, CipherMode mode, JobControl* job) {
+    dispatcher.setScheduler(&scheduler_);
+    dispatcher.setMembership(membership_.get());
+    if (memoryBudget_ && !sharedStorage_) {
+        dispatcher.setMemoryBudget(memoryBudget_.get(), chunkSize);
+    }
+    dispatcher.setCipherMode(mode);
+    dispatcher.setUseStreaming(useStreaming_);
+    dispatcher.setBatchLimits(maxBatchChunks_, maxBatchBytes_);
+    dispatcher.setHedgePercentile(hedgePercentile_);
+    dispatcher.setRetryPolicy(maxRetries_, std::chrono::milliseconds(200));
+    if (useSharedMemory_ && !sharedStorage_) {
+        dispatcher.setSameHostWorkers(sameHost_, chunkSize);
+    }
+    if (localPool_ && !sharedStorage_) {
+        dispatcher.setLocalPool(localPool_.get(), preferLocal(bytes, mode));
+    }
+    if (job) {
+        if (job->shares) {
+            dispatcher.setFairShare(job->shares, job->shareId);
+        }
+        dispatcher.setCancelFlag(&job->cancelled);
     }
 }
 
@@ -57,56 +136,18 @@ std::vector<FileChunk> EncryptionMaster::encryptFile(const std::string& filePath
     
     std::vector<FileChunk> encryptedChunks(chunks.size());
     
-    // Process chunks sequentially for simplicity and reliability
-    for (size_t i = 0; i < chunks.size(); ++i) {
-        size_t workerIndex = i % stubs_.size();
-        std::cout << "Processing chunk " << i << " with worker " << workerIndex << std::endl;
-        
-        try {
-            encryption::ChunkRequest request;
-            request.set_data(chunks[i].data.data(), chunks[i].data.size());
-            request.set_chunk_id(chunks[i].id);
-            request.set_key(key.data(), key.size());
-            request.set_iv(iv.data(), iv.size());
-            
-            encryption::ChunkResponse response;
-            grpc::ClientContext context;
-            
-            // Set a longer timeout for encryption (30 seconds)
-            auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(30);
-            context.set_deadline(deadline);
-            
-            std::cout << "Sending EncryptChunk request for chunk " << i << " (" << chunks[i].data.size() << " bytes)" << std::endl;
-            grpc::Status status = stubs_[workerIndex]->EncryptChunk(&context, request, &response);
-            
-            if (!status.ok() || !response.success()) {
-                std::string error = "Encryption failed for chunk " + std::to_string(i);
-                if (!status.ok()) {
-                    error += ", gRPC status: " + status.error_message();
-                    error += ", Error code: " + std::to_string(status.error_code());
-                    error += ", Details: " + status.error_details();
-                }
-                if (!response.success()) {
-                    error += ", Response message: " + response.error_message();
-                }
-                
-                std::cerr << error << std::endl;
-                throw std::runtime_error(error);
-            }
-            
-            std::cout << "Successfully encrypted chunk " << i << " (" << response.processed_data().size() << " bytes)" << std::endl;
-            
-            FileChunk encryptedChunk;
-            encryptedChunk.id = response.chunk_id();
-            encryptedChunk.data.assign(response.processed_data().begin(), 
-                                     response.processed_data().end());
-            encryptedChunks[i] = encryptedChunk;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Exception processing chunk " << i << ": " << e.what() << std::endl;
-            throw; // Re-throw to propagate the error
-        }
-    }
+    // Keep every worker busy with up to maxInFlightPerWorker_ outstanding requests
+    ChunkDispatcher dispatcher(membership_->pools(), maxInFlightPerWorker_);
+    configureDispatcher(dispatcher, totalBytes(chunks), chunkSize, CipherMode::AES_256_CBC);
+    dispatcher.dispatch(chunks, ChunkOperation::Encrypt, key, iv,
+        [&](size_t index, FileChunk&& result) {
+            std::cout << "Successfully encrypted chunk " << index << " (" << result.data.size() << " bytes)" << std::endl;
+            encryptedChunks[index] = std::move(result);
+        },
+        [&](size_t index, const FileChunk& input, const std::string& error) {
+            std::cerr << error << std::endl;
+            throw std::runtime_error(error);
+        });
     
     std::cout << "All chunks processed successfully" << std::endl;
     
@@ -133,43 +174,319 @@ std::vector<FileChunk> EncryptionMaster::encryptFile(const std::string& filePath
     return encryptedChunks;
 }
 
+// Streams the input through the workers into a framed container. The layout
+// (header, chunk index, data offsets) is planned up front, so each encrypted
+// chunk is written at its final offset the moment it completes and only the
+// chunks in flight are ever held in memory.
+bool EncryptionMaster::encryptFileTo(const std::string& inputPath,
+                                     const std::string& outputPath,
+                                     size_t chunkSize,
+                                     const std::string& key,
+                                     const std::string& iv,
+                                     JobControl* job) {
+    ChunkReader reader(inputPath, chunkSize);
+    ContainerLayout layout = ContainerLayout::plan(cipherMode_,
+                                                   static_cast<uint32_t>(chunkSize),
+                                                   reader.fileSize());
+    const auto& entries = layout.entries();
+    std::cout << "Encrypting " << inputPath << " (" << reader.fileSize() << " bytes, "
+              << entries.size() << " chunks, " << AESCrypto::cipherModeName(cipherMode_)
+              << ") into " << outputPath << std::endl;
+    
+    // GCM derives every chunk nonce from a fresh file nonce stored in the
+    // header, and authenticates the header with every chunk
+    if (cipherMode_ == CipherMode::AES_256_GCM) {
+        layout.header().cipherParams = AESCrypto::generateNonce();
+    }
+    std::string chunkIV = layout.chunkIV(iv);
+    
+    PositionalFileWriter writer(outputPath, entries.size(), sharedStorage_);
+    std::vector<char> headerAndIndex = layout.serializeHeaderAndIndex();
+    writer.writeAt(0, headerAndIndex.data(), headerAndIndex.size());
+    
+    ChunkDispatcher dispatcher(membership_->pools(), maxInFlightPerWorker_);
+    configureDispatcher(dispatcher, reader.fileSize(), chunkSize, cipherMode_, job);
+    if (job) {
+        job->chunksTotal = entries.size();
+    }
+    ChunkDispatcher::ChunkSource source = [&](FileChunk& chunk) { return reader.next(chunk); };
+    size_t nextEntry = 0;
+    if (sharedStorage_) {
+        // Only the plan leaves the master: each chunk is the plaintext range
+        // and the ciphertext offset already fixed by the index
+        dispatcher.setSharedStorage(std::filesystem::absolute(inputPath).string(),
+                                    std::filesystem::absolute(outputPath).string());
+        source = [&](FileChunk& chunk) {
+            if (nextEntry >= entries.size()) {
+                return false;
+            }
+            size_t i = nextEntry++;
+            chunk.id = static_cast<int>(i);
+            chunk.offset = static_cast<uint64_t>(i) * chunkSize;
+            chunk.length = entries[i].plainLength;
+            chunk.outputOffset = entries[i].cipherOffset;
+            return true;
+        };
+    }
+    dispatcher.dispatch(source,
+        ChunkOperation::Encrypt, key, chunkIV,
+        [&](size_t index, FileChunk&& result) {
+            const ContainerIndexEntry& entry = entries[index];
+            if (result.byteCount() != entry.cipherLength) {
+                throw std::runtime_error("Encrypted chunk " + std::to_string(index) + " is " +
+                                         std::to_string(result.byteCount()) + " bytes, expected " +
+                                         std::to_string(entry.cipherLength));
+            }
+            if (sharedStorage_) {
+                writer.recordChunk(index, result.length);
+            } else {
+                writer.writeChunk(index, entry.cipherOffset, result.data);
+            }
+            if (job) {
+                ++job->chunksDone;
+            }
+        },
+        [&](size_t index, const FileChunk& input, const std::string& error) {
+            std::cerr << error << std::endl;
+            throw std::runtime_error(error);
+        });
+    
+    // The footer goes last so a partially written container is detectable
+    std::vector<char> footer = layout.serializeFooter();
+    writer.writeAt(layout.footerOffset(), footer.data(), footer.size());
+    
+    uint64_t totalBytes = writer.bytesWritten();
+    if (!writer.close()) {
+        std::cerr << "Error finalizing output file: " << outputPath << std::endl;
+        return false;
+    }
+    
+    std::cout << "Successfully wrote " << entries.size() << " chunks (" << totalBytes
+              << " bytes of ciphertext, " << layout.totalSize() << " bytes total) to " << outputPath << std::endl;
+    return true;
+}
+
+// Plans the chunk boundaries of an encrypted file from its index table, or
+// from the fixed chunk size for unframed files written by older versions
+ContainerLayout EncryptionMaster::planDecryption(const std::string& inputPath, size_t chunkSize) {
+    if (ContainerLayout::isContainer(inputPath)) {
+        return ContainerLayout::read(inputPath);
+    }
+    
+    std::cout << "No container header found, treating " << inputPath << " as an unframed legacy file" << std::endl;
+    uint64_t fileSize = std::filesystem::file_size(inputPath);
+    return ContainerLayout::legacy(fileSize, static_cast<uint32_t>(FileChunker::effectiveChunkSize(chunkSize)));
+}
+
+// Decrypts every chunk listed in the layout in parallel and writes each one at
+// its plaintext offset as soon as it completes
+bool EncryptionMaster::decryptFileTo(const std::string& inputPath,
+                                     const std::string& outputPath,
+                                     size_t chunkSize,
+                                     const std::string& key,
+                                     const std::string& iv,
+                                     JobControl* job) {
+    ContainerLayout layout = planDecryption(inputPath, chunkSize);
+    const auto& entries = layout.entries();
+    CipherMode mode = layout.header().cipher;
+    std::cout << "Decrypting " << inputPath << " (" << entries.size() << " chunks of "
+              << layout.header().chunkSize << " bytes, " << AESCrypto::cipherModeName(mode)
+              << ") into " << outputPath << std::endl;
+    
+    std::string chunkIV = layout.chunkIV(iv);
+    
+    ChunkReader reader(inputPath, layout.header().chunkSize);
+    PositionalFileWriter writer(outputPath, entries.size(), sharedStorage_);
+    
+    size_t nextEntry = 0;
+    ChunkDispatcher dispatcher(membership_->pools(), maxInFlightPerWorker_);
+    configureDispatcher(dispatcher, layout.totalSize(), layout.header().chunkSize, mode, job);
+    if (job) {
+        job->chunksTotal = entries.size();
+    }
+    dispatcher.setCallTimeout(std::chrono::seconds(10));
+    if (sharedStorage_) {
+        dispatcher.setSharedStorage(std::filesystem::absolute(inputPath).string(),
+                                    std::filesystem::absolute(outputPath).string());
+    }
+    dispatcher.dispatch(
+        [&](FileChunk& chunk) {
+            if (nextEntry >= entries.size()) {
+                return false;
+            }
+            size_t i = nextEntry++;
+            const ContainerIndexEntry& entry = entries[i];
+            if (!sharedStorage_) {
+                return reader.readRange(entry.cipherOffset, entry.cipherLength, chunk);
+            }
+            chunk.id = static_cast<int>(i);
+            chunk.offset = entry.cipherOffset;
+            chunk.length = entry.cipherLength;
+            chunk.outputOffset = layout.plainOffset(i);
+            return true;
+        },
+        ChunkOperation::Decrypt, key, chunkIV,
+        [&](size_t index, FileChunk&& result) {
+            if (layout.isFramed() && result.byteCount() != entries[index].plainLength) {
+                throw std::runtime_error("Decrypted chunk " + std::to_string(index) + " is " +
+                                         std::to_string(result.byteCount()) + " bytes, expected " +
+                                         std::to_string(entries[index].plainLength));
+            }
+            if (sharedStorage_) {
+                writer.recordChunk(index, result.length);
+            } else {
+                writer.writeChunk(index, layout.plainOffset(index), result.data);
+            }
+            if (job) {
+                ++job->chunksDone;
+            }
+        },
+        [&](size_t index, const FileChunk& input, const std::string& error) {
+            std::cerr << error << std::endl;
+            throw std::runtime_error(error);
+        });
+    
+    uint64_t totalBytes = writer.bytesWritten();
+    size_t chunksWritten = writer.completedChunks();
+    if (!writer.close()) {
+        std::cerr << "Error finalizing output file: " << outputPath << std::endl;
+        return false;
+    }
+    
+    if (layout.isFramed() && totalBytes != layout.header().originalLength) {
+        std::cerr << "Decrypted size " << totalBytes << " does not match original length "
+                  << layout.header().originalLength << std::endl;
+        return false;
+    }
+    
+    std::cout << "Successfully wrote " << totalBytes << " bytes in " << chunksWritten
+              << " chunks to " << outputPath << std::endl;
+    return true;
+}
+
 // Add to master.cpp
+// Starting weight for a worker from what it reports: its crypto rate, less
+// the share its current queue takes up, capped by what the link can carry
+static double expectedThroughput(const encryption::TestResponse& response, double linkBytesPerSecond) {
+    if (response.bytes_per_second() <= 0) {
+        return 0;
+    }
+    double cores = std::max<uint32_t>(1, response.cores());
+    double rate = response.bytes_per_second() * cores / (cores + response.queue_depth());
+    return std::min(rate, linkBytesPerSecond);
+}
+
 bool EncryptionMaster::testWorkerConnections() {
-    std::cout << "Testing connections to " << stubs_.size() << " workers..." << std::endl;
-    for (size_t i = 0; i < stubs_.size(); ++i) {
+    std::vector<WorkerMember> members = membership_->snapshot();
+    size_t remoteCount = 0;
+    for (const auto& member : members) {
+        remoteCount += member.pool ? 1 : 0;
+    }
+    std::cout << "Testing connections to " << remoteCount << " workers..." << std::endl;
+    rttMs_.assign(members.size(), 0);
+    sameHost_.assign(members.size(), false);
+    std::string hostIdentity = SharedRing::hostIdentity();
+    if (scheduler_.size() < members.size()) {
+        scheduler_.resize(members.size());
+    }
+
+    // Every worker is pinged at once, so startup waits for the slowest answer
+    // (at most one deadline) rather than the sum of them
+    struct Probe {
+        size_t index = 0;
         grpc::ClientContext context;
-        encryption::TestRequest request;
         encryption::TestResponse response;
+        grpc::Status status;
+        std::chrono::steady_clock::time_point sentAt;
+        ChannelPool::Lease channel;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<encryption::TestResponse>> reader;
+    };
+    grpc::CompletionQueue cq;
+    std::vector<std::unique_ptr<Probe>> probes;
+    auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(5);
+    encryption::TestRequest request;
+    request.set_test_message("ping");
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (!members[i].pool) {
+            continue;  // The local pool
+        }
+        auto probe = std::make_unique<Probe>();
+        probe->index = i;
+        probe->context.set_deadline(deadline);
+        probe->channel = members[i].pool->lease();
+        probe->sentAt = std::chrono::steady_clock::now();
+        probe->reader = probe->channel->PrepareAsyncTestConnection(&probe->context, request, &cq);
+        probe->reader->StartCall();
+        probe->reader->Finish(&probe->response, &probe->status, probe.get());
+        probes.push_back(std::move(probe));
+    }
 
-        // Set a timeout (5 seconds)
-        auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(5);
-        context.set_deadline(deadline);
-
-        // Add optional test message if needed
-        request.set_test_message("ping");
-        
-        std::cout << "Testing worker " << i << "..." << std::endl;
-        grpc::Status status = stubs_[i]->TestConnection(&context, request, &response);
+    size_t reachable = 0;
+    void* tag = nullptr;
+    bool ok = false;
+    for (size_t pending = probes.size(); pending > 0 && cq.Next(&tag, &ok); --pending) {
+        Probe& probe = *static_cast<Probe*>(tag);
+        size_t i = probe.index;
+        const encryption::TestResponse& response = probe.response;
+        rttMs_[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - probe.sentAt).count();
 
-        if (!status.ok()) {
+        if (!ok || !probe.status.ok()) {
             std::cerr << "Worker " << i << " connection failed: " 
-                     << status.error_message() << std::endl;
-            std::cerr << "Error details: " << status.error_details() << std::endl;
-            std::cerr << "Error code: " << status.error_code() << std::endl;
-            return false;
+                     << probe.status.error_message() << std::endl;
+            std::cerr << "Error code: " << probe.status.error_code() << std::endl;
+            std::cerr << "Taking worker " << i << " out of rotation until it answers" << std::endl;
+            scheduler_.markUnavailable(i);
+            continue;
         }
 
         // Check response content
         if (!response.alive()) {
-            std::cerr << "Worker " << i << " reported unhealthy status" << std::endl;
-            return false;
+            std::cerr << "Worker " << i << " reported unhealthy status, taking it out of rotation" << std::endl;
+            scheduler_.markUnavailable(i);
+            continue;
         }
-        
+        // Older workers list no ciphers and only run CBC
+        bool cipherSupported = cipherMode_ == CipherMode::AES_256_CBC && response.ciphers_size() == 0;
+        for (int c = 0; c < response.ciphers_size(); ++c) {
+            cipherSupported |= response.ciphers(c) == static_cast<encryption::Cipher>(cipherMode_);
+        }
+        if (!cipherSupported) {
+            std::cerr << "Worker " << i << " does not support " << AESCrypto::cipherModeName(cipherMode_)
+                      << ", taking it out of rotation" << std::endl;
+            scheduler_.markUnavailable(i);
+            continue;
+        }
+
         std::cout << "Connection to worker " << i << " successful (ID: " 
-                 << response.worker_id() << ", Status: " << response.status() << ")" << std::endl;
+                 << response.worker_id() << ", Status: " << response.status() << ", "
+                 << static_cast<long>(rttMs_[i]) << " ms)" << std::endl;
+        if (response.cores() > 0) {
+            std::cout << "Worker " << i << ": " << response.cores() << " cores, "
+                      << static_cast<long>(response.bytes_per_second() / (1024 * 1024)) << " MB/s, "
+                      << (response.aes_ni() ? "AES-NI, " : "no AES-NI, ")
+                      << response.queue_depth() << " chunks queued" << std::endl;
+            // The cores set the worker's request window, as for registered workers
+            membership_->heartbeat(members[i].address, response.queue_depth(), response.cores());
+        }
+        // Workers on this host get chunks through shared memory, so no link caps them
+        sameHost_[i] = !hostIdentity.empty() && response.host_identity() == hostIdentity;
+        if (sameHost_[i]) {
+            std::cout << "Worker " << i << " runs on this host" << std::endl;
+        }
+        double expected = expectedThroughput(response, sameHost_[i] ? std::numeric_limits<double>::infinity()
+                                                                    : kAssumedLinkBytesPerSecond);
+        if (expected > 0) {
+            scheduler_.setExpectedThroughput(i, expected);
+        }
+        scheduler_.markAvailable(i);
+        ++reachable;
     }
     
-    std::cout << "All worker connections tested successfully" << std::endl;
+    if (reachable == 0 && !localPool_) {
+        std::cerr << "No workers are reachable" << std::endl;
+        return false;
+    }
+    std::cout << reachable << " of " << remoteCount << " worker connections tested successfully" << std::endl;
     return true;
 }
 
@@ -177,136 +494,32 @@ std::vector<FileChunk> EncryptionMaster::decryptFile(const std::string& filePath
                                                    size_t chunkSize,
                                                    const std::string& key,
                                                    const std::string& iv) {
-    // Split file into chunks
-    auto chunks = FileChunker::chunkFile(filePath, chunkSize);
+    // Read the ciphertext chunks at the boundaries recorded when encrypting
+    ContainerLayout layout = planDecryption(filePath, chunkSize);
+    ChunkReader reader(filePath, layout.header().chunkSize);
+    std::vector<FileChunk> chunks(layout.entries().size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        reader.readRange(layout.entries()[i].cipherOffset, layout.entries()[i].cipherLength, chunks[i]);
+    }
     std::vector<FileChunk> decryptedChunks(chunks.size());
+    CipherMode mode = layout.header().cipher;
     
     std::cout << "Decrypting file with " << chunks.size() << " chunks" << std::endl;
     
-    // Process chunks sequentially (required for CBC mode)
-    for (size_t i = 0; i < chunks.size(); ++i) {
-        size_t workerIndex = i % stubs_.size();
-        
-        // Special handling for chunks at the AES block boundary
-        // Check if chunk size is divisible by 16 (AES block size)
-        bool isBlockAligned = chunks[i].data.size() % 16 == 0;
-        
-        std::cout << "Processing chunk " << i << " (" << chunks[i].data.size() 
-                  << " bytes) on worker " << workerIndex
-                  << ", block aligned: " << (isBlockAligned ? "yes" : "no") << std::endl;
-        
-        encryption::ChunkRequest request;
-        request.set_data(chunks[i].data.data(), chunks[i].data.size());
-        request.set_chunk_id(chunks[i].id);
-        request.set_key(key.data(), key.size());
-        request.set_iv(iv.data(), iv.size());
-        
-        // Don't try to set block_aligned - we removed this earlier to fix protobuf issue
-        // We'll rely on the worker detecting this based on the data size
-        
-        encryption::ChunkResponse response;
-        grpc::ClientContext context;
-        
-        // Set a timeout for the operation
-        auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(10);
-        context.set_deadline(deadline);
-        
-        std::cout << "Sending DecryptChunk request for chunk " << i << std::endl;
-        grpc::Status status = stubs_[workerIndex]->DecryptChunk(&context, request, &response);
-        
-        if (!status.ok() || !response.success()) {
-            // If decryption failed and the chunk was block-aligned, try with a slightly modified approach
-            if (isBlockAligned && chunks[i].data.size() >= 16) {
-                std::cout << "Retrying decryption for block-aligned chunk " << i << std::endl;
-                
-                // Create a new request with the data split into two parts
-                // This avoids the AES padding issue at block boundaries
-                size_t firstPartSize = chunks[i].data.size() - 16;
-                
-                encryption::ChunkRequest firstRequest;
-                firstRequest.set_data(chunks[i].data.data(), firstPartSize);
-                firstRequest.set_chunk_id(chunks[i].id);
-                firstRequest.set_key(key.data(), key.size());
-                firstRequest.set_iv(iv.data(), iv.size());
-                
-                encryption::ChunkResponse firstResponse;
-                grpc::ClientContext firstContext;
-                
-                firstContext.set_deadline(deadline); // Use the same deadline
-                
-                grpc::Status firstStatus = stubs_[workerIndex]->DecryptChunk(&firstContext, firstRequest, &firstResponse);
-                
-                if (!firstStatus.ok() || !firstResponse.success()) {
-                    std::string error = "Decryption failed for chunk " + std::to_string(i);
-                    if (!firstStatus.ok()) {
-                        error += ", Status: " + firstStatus.error_message();
-                    }
-                    if (!firstResponse.success()) {
-                        error += ", Error: " + firstResponse.error_message();
-                    }
-                    std::cerr << error << std::endl;
-                    throw std::runtime_error(error);
-                }
-                
-                encryption::ChunkRequest secondRequest;
-                secondRequest.set_data(chunks[i].data.data() + firstPartSize, 16);
-                secondRequest.set_chunk_id(chunks[i].id + 1000); // Use a different ID for the second part
-                secondRequest.set_key(key.data(), key.size());
-                secondRequest.set_iv(iv.data(), iv.size());
-                
-                encryption::ChunkResponse secondResponse;
-                grpc::ClientContext secondContext;
-                
-                secondContext.set_deadline(deadline); // Use the same deadline
-                
-                grpc::Status secondStatus = stubs_[workerIndex]->DecryptChunk(&secondContext, secondRequest, &secondResponse);
-                
-                if (!secondStatus.ok() || !secondResponse.success()) {
-                    std::string error = "Decryption failed for chunk " + std::to_string(i) + " (part 2)";
-                    if (!secondStatus.ok()) {
-                        error += ", Status: " + secondStatus.error_message();
-                    }
-                    if (!secondResponse.success()) {
-                        error += ", Error: " + secondResponse.error_message();
-                    }
-                    std::cerr << error << std::endl;
-                    throw std::runtime_error(error);
-                }
-                
-                // Combine the two decrypted parts
-                FileChunk decryptedChunk;
-                decryptedChunk.id = chunks[i].id;
-                
-                // Combine the first and second parts
-                std::vector<char> combinedData;
-                combinedData.reserve(firstResponse.processed_data().size() + secondResponse.processed_data().size());
-                combinedData.insert(combinedData.end(), firstResponse.processed_data().begin(), firstResponse.processed_data().end());
-                combinedData.insert(combinedData.end(), secondResponse.processed_data().begin(), secondResponse.processed_data().end());
-                
-                decryptedChunk.data = std::move(combinedData);
-                decryptedChunks[i] = decryptedChunk;
-                
-                std::cout << "Successfully decrypted chunk " << i << " (split approach)" << std::endl;
-            } else {
-                std::string error = "Decryption failed for chunk " + std::to_string(i);
-                if (!status.ok()) {
-                    error += ", Status: " + status.error_message();
-                }
-                if (!response.success()) {
-                    error += ", Error: " + response.error_message();
-                }
-                std::cerr << error << std::endl;
-                throw std::runtime_error(error);
-            }
-        } else {
-            FileChunk decryptedChunk;
-            decryptedChunk.id = response.chunk_id();
-            decryptedChunk.data.assign(response.processed_data().begin(), 
-                                     response.processed_data().end());
-            decryptedChunks[i] = decryptedChunk;
-            std::cout << "Successfully decrypted chunk " << i << std::endl;
-        }
-    }
+    // Every chunk was encrypted independently, so they can all be in flight at once
+    ChunkDispatcher dispatcher(membership_->pools(), maxInFlightPerWorker_);
+    configureDispatcher(dispatcher, totalBytes(chunks), layout.header().chunkSize, mode);
+    dispatcher.setCallTimeout(std::chrono::seconds(10));
+    dispatcher.dispatch(chunks, ChunkOperation::Decrypt, key,
+        layout.chunkIV(iv),
+        [&](size_t index, FileChunk&& result) {
+            std::cout << "Successfully decrypted chunk " << index << std::endl;
+            decryptedChunks[index] = std::move(result);
+        },
+        [&](size_t index, const FileChunk& input, const std::string& error) {
+            std::cerr << error << std::endl;
+            throw std::runtime_error(error);
+        });
     
     std::cout << "All chunks decrypted successfully" << std::endl;
     
@@ -395,135 +608,27 @@ bool EncryptionMaster::writeProcessedDataToFile(const std::string& outputPath, c
         }
     }
     
-    // Try direct std::ofstream approach first
-    {
-        std::cout << "METHOD 1: Attempting to write file using std::ofstream: " << outputPath << std::endl;
-        std::ofstream outFile(outputPath, std::ios::binary);
-        if (outFile.is_open()) {
-            std::cout << "File opened successfully with std::ofstream" << std::endl;
-            
-            // Sort chunks by ID before writing
-            std::vector<FileChunk> sortedChunks = chunks;
-            std::sort(sortedChunks.begin(), sortedChunks.end(), 
-                      [](const FileChunk& a, const FileChunk& b) { return a.id < b.id; });
-            
-            size_t totalBytes = 0;
-            for (const auto& chunk : sortedChunks) {
-                if (chunk.data.empty()) {
-                    std::cerr << "Warning: Chunk " << chunk.id << " is empty, skipping" << std::endl;
-                    continue;
-                }
-                
-                outFile.write(chunk.data.data(), chunk.data.size());
-                if (outFile.fail()) {
-                    std::cerr << "Error writing chunk " << chunk.id << " to file" << std::endl;
-                    outFile.close();
-                    
-                    // Try to diagnose the issue
-                    std::cerr << "Write error: " << strerror(errno) << " (code: " << errno << ")" << std::endl;
-                } else {
-                    totalBytes += chunk.data.size();
-                    std::cout << "Wrote chunk " << chunk.id << " (" << chunk.data.size() << " bytes)" << std::endl;
-                }
-            }
-            
-            outFile.close();
+    // Write every chunk at its final offset; chunks are laid out by id without
+    // copying or sorting the chunk data
+    try {
+        std::cout << "Writing " << chunks.size() << " chunks with positional writer: " << outputPath << std::endl;
+        PositionalFileWriter writer(outputPath, chunks.size());
+        writer.writeChunks(chunks);
+        uint64_t totalBytes = writer.bytesWritten();
+        if (writer.close()) {
             std::cout << "Closed output file after writing " << totalBytes << " bytes" << std::endl;
             
-            // Verify file was created successfully
-            try {
-                if (std::filesystem::exists(outputPath)) {
-                    auto fileSize = std::filesystem::file_size(outputPath);
-                    std::cout << "Successfully created output file: " << outputPath 
-                              << " (size: " << fileSize << " bytes)" << std::endl;
-                    return true;
-                } else {
-                    std::cerr << "File writing appeared to succeed but file doesn't exist: " << outputPath << std::endl;
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error verifying file: " << e.what() << std::endl;
-            }
-        } else {
-            std::cerr << "Failed to open output file with std::ofstream: " << outputPath << std::endl;
-            std::cerr << "Error: " << strerror(errno) << " (code: " << errno << ")" << std::endl;
-        }
-    }
-    
-    // Try Windows API direct file creation
-    {
-        std::cout << "METHOD 2: Attempting to write file using Windows API: " << outputPath << std::endl;
-        
-        std::wstring wideOutputPath = StringToWString(outputPath);
-        HANDLE hFile = CreateFileW(
-            wideOutputPath.c_str(),
-            GENERIC_WRITE,
-            0,
-            NULL,
-            CREATE_ALWAYS,
-            FILE_ATTRIBUTE_NORMAL,
-            NULL
-        );
-        
-        if (hFile != INVALID_HANDLE_VALUE) {
-            std::cout << "File opened successfully with Windows API" << std::endl;
-            
-            // Sort chunks by ID before writing
-            std::vector<FileChunk> sortedChunks = chunks;
-            std::sort(sortedChunks.begin(), sortedChunks.end(), 
-                      [](const FileChunk& a, const FileChunk& b) { return a.id < b.id; });
-            
-            size_t totalBytes = 0;
-            bool success = true;
-            for (const auto& chunk : sortedChunks) {
-                if (chunk.data.empty()) {
-                    std::cerr << "Warning: Chunk " << chunk.id << " is empty, skipping" << std::endl;
-                    continue;
-                }
-                
-                DWORD bytesWritten = 0;
-                if (!WriteFile(
-                    hFile,
-                    chunk.data.data(),
-                    static_cast<DWORD>(chunk.data.size()),
-                    &bytesWritten,
-                    NULL
-                )) {
-                    DWORD error = GetLastError();
-                    std::cerr << "Error writing chunk " << chunk.id << " to file: " << error << std::endl;
-                    success = false;
-                    break;
-                }
-                
-                totalBytes += bytesWritten;
-                std::cout << "Wrote chunk " << chunk.id << " (" << bytesWritten << " bytes)" << std::endl;
-            }
-            
-            FlushFileBuffers(hFile);
-            CloseHandle(hFile);
-            std::cout << "Closed output file after writing " << totalBytes << " bytes" << std::endl;
-            
-            if (success) {
-                try {
-                    if (std::filesystem::exists(outputPath)) {
-                        auto fileSize = std::filesystem::file_size(outputPath);
-                        std::cout << "Successfully created output file: " << outputPath 
-                                  << " (size: " << fileSize << " bytes)" << std::endl;
-                        return true;
-                    } else {
-                        std::cerr << "File writing appeared to succeed but file doesn't exist: " << outputPath << std::endl;
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "Error verifying file: " << e.what() << std::endl;
-                }
-            }
-        } else {
-            DWORD error = GetLastError();
-            std::cerr << "Failed to open output file with Windows API: " << outputPath << std::endl;
-            std::cerr << "Error: " << error << std::endl;
+            auto fileSize = std::filesystem::file_size(outputPath);
+            std::cout << "Successfully created output file: " << outputPath 
+                      << " (size: " << fileSize << " bytes)" << std::endl;
+            return true;
         }
+        std::cerr << "Positional writer failed to finalize: " << outputPath << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error writing output file: " << e.what() << std::endl;
     }
     
     // If we get here, try FileChunker as a last resort
-    std::cout << "METHOD 3: Falling back to FileChunker::reassembleFile method" << std::endl;
+    std::cout << "Falling back to FileChunker::reassembleFile method" << std::endl;
     return FileChunker::reassembleFile(outputPath, chunks);
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "membership.h"
+#include <iostream>
+
+WorkerMembership::WorkerMembership(bool useTLS, size_t connectionsPerWorker,
+                                   std::chrono::milliseconds heartbeatTimeout)
+    : useTLS_(useTLS), connectionsPerWorker_(connectionsPerWorker), heartbeatTimeout_(heartbeatTimeout) {
+}
+
+size_t WorkerMembership::findLocked(const std::string& address) const {
+    for (size_t i = 0; i < members_.size(); ++i) {
+        if (members_[i].pool && members_[i].address == address) {
+            return i;
+        }
+    }
+    return members_.size();
+}
+
+size_t WorkerMembership::add(const std::string& address) {
+    // Channels come from the process-wide registry, so they are reused across masters
+    auto pool = ChannelRegistry::instance().pool(address, useTLS_, connectionsPerWorker_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = findLocked(address);
+    if (index < members_.size()) {
+        return index;
+    }
+    WorkerMember member;
+    member.address = address;
+    member.pool = std::move(pool);
+    members_.push_back(std::move(member));
+    ++version_;
+    return members_.size() - 1;
+}
+
+size_t WorkerMembership::addLocal() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < members_.size(); ++i) {
+        if (!members_[i].pool) {
+            return i;
+        }
+    }
+    members_.emplace_back();
+    ++version_;
+    return members_.size() - 1;
+}
+
+size_t WorkerMembership::registerWorker(const std::string& address, size_t capacity) {
+    auto pool = ChannelRegistry::instance().pool(address, useTLS_, connectionsPerWorker_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = findLocked(address);
+    if (index == members_.size()) {
+        WorkerMember member;
+        member.address = address;
+        member.pool = std::move(pool);
+        members_.push_back(std::move(member));
+        std::cout << "Worker " << address << " registered as worker " << index << std::endl;
+    } else {
+        std::cout << "Worker " << address << " registered again as worker " << index << std::endl;
+    }
+    WorkerMember& member = members_[index];
+    member.state = MemberState::Active;
+    member.registered = true;
+    member.capacity = capacity;
+    member.queueDepth = 0;
+    member.lastHeartbeat = Clock::now();
+    ++version_;
+    return index;
+}
+
+bool WorkerMembership::heartbeat(const std::string& address, size_t queueDepth, size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = findLocked(address);
+    if (index == members_.size() || members_[index].state == MemberState::Gone) {
+        return false;
+    }
+    WorkerMember& member = members_[index];
+    member.queueDepth = queueDepth;
+    member.capacity = capacity;
+    member.lastHeartbeat = Clock::now();
+    return true;
+}
+
+bool WorkerMembership::drain(const std::string& address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = findLocked(address);
+    if (index == members_.size()) {
+        return false;
+    }
+    if (members_[index].state == MemberState::Active) {
+        std::cout << "Draining worker " << index << " (" << address << ")" << std::endl;
+        members_[index].state = MemberState::Draining;
+        ++version_;
+    }
+    return true;
+}
+
+// Registered workers that stopped sending heartbeats are dropped, draining
+// ones included: a worker that went quiet will not finish its chunks
+void WorkerMembership::expireLocked(Clock::time_point now) {
+    for (size_t i = 0; i < members_.size(); ++i) {
+        WorkerMember& member = members_[i];
+        if (!member.registered || member.state == MemberState::Gone ||
+            now - member.lastHeartbeat <= heartbeatTimeout_) {
+            continue;
+        }
+        std::cerr << "Worker " << i << " (" << member.address << ") sent no heartbeat for "
+                  << heartbeatTimeout_.count() << " ms, dropping it" << std::endl;
+        member.state = MemberState::Gone;
+        ++version_;
+    }
+}
+
+uint64_t WorkerMembership::version() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expireLocked(Clock::now());
+    return version_;
+}
+
+std::vector<WorkerMember> WorkerMembership::snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expireLocked(Clock::now());
+    return members_;
+}
+
+std::vector<std::shared_ptr<ChannelPool>> WorkerMembership::pools() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<ChannelPool>> pools;
+    pools.reserve(members_.size());
+    for (const auto& member : members_) {
+        pools.push_back(member.pool);
+    }
+    return pools;
+}
+
+size_t WorkerMembership::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return members_.size();
+}
@@ -0,0 +1,25 @@
+#include "memory_budget.h"
+#include <algorithm>
+
+MemoryBudget::MemoryBudget(uint64_t capacity)
+    : capacity_(capacity) {
+}
+
+bool MemoryBudget::tryAcquire(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (used_ + bytes > capacity_ && used_ > 0) {
+        return false;
+    }
+    used_ += bytes;
+    return true;
+}
+
+void MemoryBudget::release(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    used_ -= std::min(bytes, used_);
+}
+
+uint64_t MemoryBudget::inUse() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_;
+}
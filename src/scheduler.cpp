@@ -0,0 +1,166 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+WorkerScheduler::WorkerScheduler(size_t workerCount) {
+    resize(workerCount);
+}
+
+void WorkerScheduler::resize(size_t workerCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers_.resize(workerCount);
+}
+
+size_t WorkerScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.size();
+}
+
+size_t WorkerScheduler::pick(const std::vector<size_t>& inFlight, size_t maxInFlight) const {
+    return pick(inFlight, std::vector<size_t>(inFlight.size(), maxInFlight));
+}
+
+size_t WorkerScheduler::pick(const std::vector<size_t>& inFlight, const std::vector<size_t>& capacity) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Workers without a measurement yet are assumed to be average so they get
+    // probed early instead of starving or being flooded
+    double measured = 0;
+    size_t measuredCount = 0;
+    for (const auto& worker : workers_) {
+        if (worker.stats.throughput > 0) {
+            measured += worker.stats.throughput;
+            ++measuredCount;
+        }
+    }
+    double fallback = measuredCount > 0 ? measured / measuredCount : 1.0;
+
+    size_t best = workers_.size();
+    double bestFinish = 0;
+    for (size_t i = 0; i < workers_.size() && i < inFlight.size() && i < capacity.size(); ++i) {
+        if (inFlight[i] >= capacity[i] || !workers_[i].stats.available) {
+            continue;
+        }
+        // Relative time for the worker to get through its queue plus one more chunk
+        double throughput = workers_[i].stats.throughput > 0 ? workers_[i].stats.throughput : fallback;
+        double finish = static_cast<double>(inFlight[i] + 1) / throughput;
+        if (best == workers_.size() || finish < bestFinish) {
+            best = i;
+            bestFinish = finish;
+        }
+    }
+    return best;
+}
+
+void WorkerScheduler::recordCompletion(size_t worker, uint64_t bytes, size_t chunks, Clock::time_point sentAt) {
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker >= workers_.size()) {
+        return;
+    }
+    Entry& entry = workers_[worker];
+    WorkerStats& stats = entry.stats;
+
+    double latencyMs = std::chrono::duration<double, std::milli>(now - sentAt).count();
+
+    // With several requests pipelined, results arrive one service time apart,
+    // so measure from the previous result when it came after this send
+    auto start = std::max(sentAt, entry.lastCompletion);
+    double seconds = std::max(std::chrono::duration<double>(now - start).count(), 1e-6);
+    double throughput = static_cast<double>(bytes) / seconds;
+
+    if (stats.chunks == 0) {
+        stats.latencyMs = latencyMs;
+        stats.throughput = throughput;
+    } else {
+        stats.latencyMs += kAlpha * (latencyMs - stats.latencyMs);
+        stats.throughput += kAlpha * (throughput - stats.throughput);
+    }
+    stats.chunks += chunks;
+    stats.bytes += bytes;
+    stats.consecutiveFailures = 0;
+    entry.lastCompletion = now;
+}
+
+void WorkerScheduler::setExpectedThroughput(size_t worker, double bytesPerSecond) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker < workers_.size() && workers_[worker].stats.chunks == 0) {
+        workers_[worker].stats.throughput = bytesPerSecond;
+    }
+}
+
+bool WorkerScheduler::recordFailure(size_t worker, bool transport) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker >= workers_.size()) {
+        return false;
+    }
+    WorkerStats& stats = workers_[worker].stats;
+    ++stats.failures;
+    if (!transport) {
+        return false;
+    }
+    ++stats.consecutiveFailures;
+    if (stats.available && stats.consecutiveFailures >= kFailureThreshold) {
+        stats.available = false;
+        return true;
+    }
+    return false;
+}
+
+bool WorkerScheduler::available(size_t worker) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return worker < workers_.size() && workers_[worker].stats.available;
+}
+
+size_t WorkerScheduler::availableCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(workers_.begin(), workers_.end(),
+                                             [](const Entry& entry) { return entry.stats.available; }));
+}
+
+void WorkerScheduler::markAvailable(size_t worker) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker < workers_.size()) {
+        workers_[worker].stats.available = true;
+        workers_[worker].stats.consecutiveFailures = 0;
+    }
+}
+
+void WorkerScheduler::markUnavailable(size_t worker) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker < workers_.size()) {
+        workers_[worker].stats.available = false;
+    }
+}
+
+std::vector<WorkerStats> WorkerScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<WorkerStats> result;
+    result.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        result.push_back(worker.stats);
+    }
+    return result;
+}
+
+std::string WorkerScheduler::summary() const {
+    std::vector<WorkerStats> all = stats();
+    uint64_t totalChunks = 0;
+    for (const auto& stats : all) {
+        totalChunks += stats.chunks;
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < all.size(); ++i) {
+        const WorkerStats& stats = all[i];
+        double share = totalChunks > 0 ? 100.0 * stats.chunks / totalChunks : 0;
+        oss << "Worker " << i << ": " << stats.chunks << " chunks (" << share << "%), "
+            << stats.bytes << " bytes, " << stats.failures << " failures, "
+            << stats.latencyMs << " ms latency, "
+            << stats.throughput / (1024 * 1024) << " MB/s"
+            << (stats.available ? "" : " (out of rotation)") << "\n";
+    }
+    return oss.str();
+}
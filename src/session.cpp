@@ -0,0 +1,67 @@
+#include "session.h"
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+#include <stdexcept>
+
+WorkerSession::WorkerSession(CipherMode mode, const std::string& key, const std::string& iv)
+    : mode(mode), key(key), iv(iv) {
+}
+
+WorkerSession::~WorkerSession() {
+    if (!key.empty()) {
+        OPENSSL_cleanse(&key[0], key.size());
+    }
+}
+
+SessionStore::SessionStore(size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1) {
+}
+
+uint64_t SessionStore::open(CipherMode mode, const std::string& key, const std::string& iv) {
+    auto session = std::make_shared<const WorkerSession>(mode, key, iv);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Random ids keep a restarted worker from matching ids handed out before the restart
+    uint64_t id = 0;
+    while (id == 0 || index_.count(id)) {
+        if (RAND_bytes(reinterpret_cast<unsigned char*>(&id), sizeof(id)) != 1) {
+            throw std::runtime_error("Failed to generate session id");
+        }
+    }
+
+    lru_.emplace_front(id, std::move(session));
+    index_[id] = lru_.begin();
+
+    if (lru_.size() > capacity_) {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+    return id;
+}
+
+bool SessionStore::close(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return false;
+    }
+    lru_.erase(it->second);
+    index_.erase(it);
+    return true;
+}
+
+std::shared_ptr<const WorkerSession> SessionStore::find(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return lru_.front().second;
+}
+
+size_t SessionStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
@@ -0,0 +1,145 @@
+#include "shared_ring.h"
+#include "utilities.h"
+#include <openssl/rand.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <windows.h>
+
+static std::atomic<uint64_t> ringsCreated{0};
+
+SharedRing::SharedRing(size_t slots, size_t slotSize)
+    : size_(static_cast<uint64_t>(slots) * slotSize),
+      slotSize_(slotSize) {
+    if (slots == 0 || slotSize == 0) {
+        throw std::runtime_error("Shared ring needs at least one non-empty slot");
+    }
+
+    // Random part so other processes in the session cannot guess the name
+    uint32_t salt = 0;
+    RAND_bytes(reinterpret_cast<unsigned char*>(&salt), sizeof(salt));
+    name_ = kNamePrefix + std::to_string(GetCurrentProcessId()) + "-" +
+            std::to_string(++ringsCreated) + "-" + std::to_string(salt);
+
+    std::wstring wideName = StringToWString(name_);
+    mapping_ = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                  static_cast<DWORD>(size_ >> 32), static_cast<DWORD>(size_ & 0xFFFFFFFF),
+                                  wideName.c_str());
+    if (!mapping_) {
+        throw std::runtime_error("Failed to create shared memory " + name_ + ", error: " +
+                                 std::to_string(GetLastError()));
+    }
+    map(static_cast<size_t>(size_));
+    for (size_t slot = 0; slot < slots; ++slot) {
+        free_.push_back(slot);
+    }
+}
+
+SharedRing::SharedRing(const std::string& name, uint64_t size)
+    : name_(name),
+      size_(size) {
+    // Chunks are written in place, so a caller must not point the worker at
+    // any other section it can open
+    if (name_.compare(0, std::strlen(kNamePrefix), kNamePrefix) != 0) {
+        throw std::invalid_argument("Not a shared-memory ring: " + name_);
+    }
+    std::wstring wideName = StringToWString(name_);
+    mapping_ = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, wideName.c_str());
+    if (!mapping_) {
+        throw std::runtime_error("Failed to open shared memory " + name_ + ", error: " +
+                                 std::to_string(GetLastError()));
+    }
+
+    // Map the whole section and check the claimed size against it
+    map(0);
+    MEMORY_BASIC_INFORMATION region = {};
+    if (VirtualQuery(view_, &region, sizeof(region)) == 0 || size_ > region.RegionSize) {
+        UnmapViewOfFile(view_);
+        CloseHandle(mapping_);
+        view_ = nullptr;
+        mapping_ = nullptr;
+        throw std::invalid_argument("Shared memory " + name_ + " is smaller than the " +
+                                    std::to_string(size) + " bytes requested");
+    }
+}
+
+void SharedRing::map(size_t length) {
+    view_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, length));
+    if (!view_) {
+        DWORD error = GetLastError();
+        CloseHandle(mapping_);
+        throw std::runtime_error("Failed to map shared memory " + name_ + ", error: " + std::to_string(error));
+    }
+}
+
+SharedRing::~SharedRing() {
+    if (view_) {
+        UnmapViewOfFile(view_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+}
+
+size_t SharedRing::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.empty()) {
+        return kNoSlot;
+    }
+    size_t slot = free_.front();
+    free_.pop_front();
+    return slot;
+}
+
+void SharedRing::release(size_t slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(slot);
+}
+
+std::string SharedRing::hostIdentity() {
+    char host[256] = {0};
+    DWORD hostSize = sizeof(host);
+    DWORD session = 0;
+    std::string identity = GetComputerNameA(host, &hostSize) ? std::string(host) : std::string();
+    if (identity.empty() || !ProcessIdToSessionId(GetCurrentProcessId(), &session)) {
+        return std::string();  // Unknown: never matches
+    }
+    return identity + "/" + std::to_string(session);
+}
+
+uint64_t SharedRingStore::attach(const std::string& name, uint64_t size) {
+    auto ring = std::make_shared<SharedRing>(name, size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t id = 0;
+    while (id == 0 || rings_.count(id)) {
+        if (RAND_bytes(reinterpret_cast<unsigned char*>(&id), sizeof(id)) != 1) {
+            throw std::runtime_error("Failed to generate ring id");
+        }
+    }
+    rings_[id] = std::move(ring);
+    order_.push_back(id);
+
+    // Masters that never detach (crashes) cannot pin memory without bound
+    while (rings_.size() > capacity_) {
+        rings_.erase(order_.front());
+        order_.pop_front();
+    }
+    return id;
+}
+
+bool SharedRingStore::detach(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!rings_.erase(id)) {
+        return false;
+    }
+    order_.erase(std::remove(order_.begin(), order_.end(), id), order_.end());
+    return true;
+}
+
+std::shared_ptr<SharedRing> SharedRingStore::find(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = rings_.find(id);
+    return it != rings_.end() ? it->second : nullptr;
+}
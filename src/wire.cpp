@@ -0,0 +1,177 @@
+#include "wire.h"
+#include <algorithm>
+#include <cstring>
+
+const char* const ChunkWire::kEncryptChunk = "/encryption.EncryptionService/EncryptChunk";
+const char* const ChunkWire::kDecryptChunk = "/encryption.EncryptionService/DecryptChunk";
+const char* const ChunkWire::kProcessRange = "/encryption.EncryptionService/ProcessRange";
+const char* const ChunkWire::kProcessChunks = "/encryption.EncryptionService/ProcessChunks";
+
+namespace {
+// Field 1 (data / processed_data) of both messages, length-delimited
+const uint32_t kPayloadTag = (1 << 3) | 2;
+
+enum WireType : uint32_t { Varint = 0, Fixed64 = 1, LengthDelimited = 2, Fixed32 = 5 };
+
+void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// The slice's reference to the payload; dropped when gRPC releases the slice
+void releasePayload(void* holder) {
+    delete static_cast<std::shared_ptr<const std::vector<char>>*>(holder);
+}
+
+// Sequential reader over the slices of a received message
+class SliceReader {
+public:
+    explicit SliceReader(std::vector<grpc::Slice> slices) : slices_(std::move(slices)) {}
+
+    bool atEnd() {
+        skipEmpty();
+        return slice_ == slices_.size();
+    }
+
+    bool readByte(uint8_t& byte) {
+        skipEmpty();
+        if (slice_ == slices_.size()) {
+            return false;
+        }
+        byte = slices_[slice_].begin()[pos_++];
+        return true;
+    }
+
+    bool readVarint(uint64_t& value, std::string* raw = nullptr) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!readByte(byte)) {
+                return false;
+            }
+            if (raw) {
+                raw->push_back(static_cast<char>(byte));
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Copies the next size bytes to out, crossing slice boundaries as needed
+    bool read(char* out, size_t size) {
+        while (size > 0) {
+            skipEmpty();
+            if (slice_ == slices_.size()) {
+                return false;
+            }
+            const grpc::Slice& slice = slices_[slice_];
+            size_t n = std::min(size, slice.size() - pos_);
+            std::memcpy(out, slice.begin() + pos_, n);
+            pos_ += n;
+            out += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool append(std::string& out, size_t size) {
+        size_t start = out.size();
+        out.resize(start + size);
+        return read(&out[start], size);
+    }
+
+private:
+    void skipEmpty() {
+        while (slice_ < slices_.size() && pos_ == slices_[slice_].size()) {
+            ++slice_;
+            pos_ = 0;
+        }
+    }
+
+    std::vector<grpc::Slice> slices_;
+    size_t slice_ = 0;
+    size_t pos_ = 0;
+};
+}
+
+grpc::ByteBuffer ChunkWire::encodeRequest(const encryption::ChunkRequest& fields,
+                                          const std::shared_ptr<const std::vector<char>>& payload) {
+    std::string head;
+    fields.SerializeToString(&head);
+    if (!payload || payload->empty()) {
+        grpc::Slice slice(head);
+        return grpc::ByteBuffer(&slice, 1);
+    }
+
+    // Fields may come in any order, so the data field can simply follow the rest
+    appendVarint(head, kPayloadTag);
+    appendVarint(head, payload->size());
+    grpc::Slice slices[2] = {
+        grpc::Slice(head),
+        grpc::Slice(const_cast<char*>(payload->data()), payload->size(), &releasePayload,
+                    new std::shared_ptr<const std::vector<char>>(payload)),
+    };
+    return grpc::ByteBuffer(slices, 2);
+}
+
+bool ChunkWire::decodeResponse(const grpc::ByteBuffer& buffer,
+                               encryption::ChunkResponse& fields,
+                               std::vector<char>& output) {
+    std::vector<grpc::Slice> slices;
+    if (!buffer.Dump(&slices).ok()) {
+        return false;
+    }
+    SliceReader reader(std::move(slices));
+
+    // Every field but the payload is gathered as-is and parsed by protobuf
+    std::string rest;
+    output.clear();
+    while (!reader.atEnd()) {
+        size_t fieldStart = rest.size();
+        uint64_t key = 0;
+        if (!reader.readVarint(key, &rest)) {
+            return false;
+        }
+        uint64_t value = 0;
+        switch (static_cast<uint32_t>(key & 7)) {
+            case Varint:
+                if (!reader.readVarint(value, &rest)) {
+                    return false;
+                }
+                break;
+            case Fixed64:
+                if (!reader.append(rest, 8)) {
+                    return false;
+                }
+                break;
+            case Fixed32:
+                if (!reader.append(rest, 4)) {
+                    return false;
+                }
+                break;
+            case LengthDelimited:
+                if (key == kPayloadTag) {
+                    rest.resize(fieldStart);
+                    if (!reader.readVarint(value)) {
+                        return false;
+                    }
+                    output.resize(static_cast<size_t>(value));
+                    if (!reader.read(output.data(), output.size())) {
+                        return false;
+                    }
+                } else if (!reader.readVarint(value, &rest) || !reader.append(rest, static_cast<size_t>(value))) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    return fields.ParseFromString(rest);
+}
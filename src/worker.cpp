@@ -1,11 +1,16 @@
 #include "worker.h"
 #include "crypto.h"
+#include "local_pool.h"
 #include "utilities.h"
 #include <iostream>
 #include <openssl/err.h>
 #include <fstream>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iomanip>
+#include <mutex>
+#include <thread>
 #include <windows.h>
 #include <psapi.h>
 
@@ -42,48 +47,175 @@ void log(const std::string& message, bool isError = false) {
     }
 }
 
-grpc::Status EncryptionWorker::EncryptChunk(grpc::ServerContext* context, 
-    const encryption::ChunkRequest* request, 
+// Cipher requested by the master; requests from older masters leave it unset
+static CipherMode toCipherMode(encryption::Cipher cipher) {
+    switch (cipher) {
+        case encryption::CIPHER_AES_256_GCM:
+            return CipherMode::AES_256_GCM;
+        case encryption::CIPHER_UNSPECIFIED:
+        case encryption::CIPHER_AES_256_CBC:
+            return CipherMode::AES_256_CBC;
+        default:
+            throw std::runtime_error("Unsupported cipher " + std::to_string(cipher));
+    }
+}
+
+// Key material for a chunk: the registered session, or the inline fields
+// sent by masters that do not open sessions
+static std::shared_ptr<const WorkerSession> requestSession(const encryption::ChunkRequest* request,
+                                                           SessionStore& sessions) {
+    if (request->session_id() != 0) {
+        auto session = sessions.find(request->session_id());
+        if (!session) {
+            throw std::runtime_error("Unknown or expired session " + std::to_string(request->session_id()));
+        }
+        return session;
+    }
+    return std::make_shared<const WorkerSession>(toCipherMode(request->cipher()), request->key(), request->iv());
+}
+
+// The attached ring a ring chunk refers to, checked to hold the chunk's
+// range; null for chunks that carry their data
+static std::shared_ptr<SharedRing> requestRing(const encryption::ChunkRequest& request, SharedRingStore& rings) {
+    if (request.ring_id() == 0) {
+        return nullptr;
+    }
+    auto ring = rings.find(request.ring_id());
+    if (!ring) {
+        throw std::runtime_error("Unknown or detached ring " + std::to_string(request.ring_id()));
+    }
+    if (request.input_length() > request.ring_capacity() || request.ring_offset() > ring->size() ||
+        request.ring_capacity() > ring->size() - request.ring_offset()) {
+        throw std::runtime_error("Ring range outside the ring");
+    }
+    return ring;
+}
+
+// Runs one chunk through this thread's keyed context, writing straight into
+// the response buffer, or in place in its ring slot; returns the output size
+static size_t transformChunk(CipherDirection direction, const encryption::ChunkRequest& request,
+                             const WorkerSession& session, encryption::ChunkResponse* response,
+                             SharedRing* ring = nullptr) {
+    CipherContext& cipher = AESCrypto::context(session.mode, direction, session.key);
+    uint64_t chunkIndex = static_cast<uint64_t>(request.chunk_id());
+    size_t size = 0;
+    if (ring) {
+        char* slot = ring->data() + request.ring_offset();
+        ConstByteSpan input(slot, static_cast<size_t>(request.input_length()));
+        MutableByteSpan output(slot, static_cast<size_t>(request.ring_capacity()));
+        size_t needed = direction == CipherDirection::Encrypt ? AESCrypto::encryptedSize(input.size, session.mode)
+                                                               : AESCrypto::maxDecryptedSize(input.size, session.mode);
+        if (needed > output.size) {
+            throw std::runtime_error("Ring slot too small for the result");
+        }
+        size = direction == CipherDirection::Encrypt ? cipher.encrypt(input, output, session.iv, chunkIndex)
+                                                     : cipher.decrypt(input, output, session.iv, chunkIndex);
+        response->set_output_length(size);
+        response->set_chunk_id(request.chunk_id());
+        return size;
+    }
+
+    const std::string& input = request.data();
+    std::string* output = response->mutable_processed_data();
+    if (direction == CipherDirection::Encrypt) {
+        output->resize(AESCrypto::encryptedSize(input.size(), session.mode));
+        size = cipher.encrypt(input, *output, session.iv, chunkIndex);
+    } else {
+        output->resize(AESCrypto::maxDecryptedSize(input.size(), session.mode));
+        size = cipher.decrypt(input, *output, session.iv, chunkIndex);
+    }
+    output->resize(size);
+    response->set_chunk_id(request.chunk_id());
+    return size;
+}
+
+EncryptionWorker::EncryptionWorker() {
+    SetMessageAllocatorFor_EncryptChunk(&chunkAllocator_);
+    SetMessageAllocatorFor_DecryptChunk(&chunkAllocator_);
+    SetMessageAllocatorFor_ProcessRange(&chunkAllocator_);
+    SetMessageAllocatorFor_EncryptBatch(&batchAllocator_);
+    SetMessageAllocatorFor_DecryptBatch(&batchAllocator_);
+}
+
+// The pool finishes its queued chunks before the allocators and stats go away
+EncryptionWorker::~EncryptionWorker() {
+    cryptoPool_.reset();
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::runOnPool(grpc::CallbackServerContext* context, size_t chunks,
+    std::function<void()> work) {
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    activeChunks_ += chunks;
+    cryptoPool_->submit([this, reactor, chunks, work = std::move(work)]() {
+        work();
+        activeChunks_ -= chunks;
+        reactor->Finish(grpc::Status::OK);
+    });
+    return reactor;
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::EncryptChunk(grpc::CallbackServerContext* context,
+    const encryption::ChunkRequest* request,
+    encryption::ChunkResponse* response) {
+    return runOnPool(context, 1, [this, request, response]() { encryptChunk(request, response); });
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::DecryptChunk(grpc::CallbackServerContext* context,
+    const encryption::ChunkRequest* request,
+    encryption::ChunkResponse* response) {
+    return runOnPool(context, 1, [this, request, response]() { decryptChunk(request, response); });
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::ProcessRange(grpc::CallbackServerContext* context,
+    const encryption::ChunkRequest* request,
+    encryption::ChunkResponse* response) {
+    return runOnPool(context, 1, [this, request, response]() { processRange(request, response); });
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::EncryptBatch(grpc::CallbackServerContext* context,
+    const encryption::BatchRequest* request,
+    encryption::BatchResponse* response) {
+    return runOnPool(context, static_cast<size_t>(request->chunks_size()), [this, request, response]() {
+        processBatch(CipherDirection::Encrypt, request, response);
+    });
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::DecryptBatch(grpc::CallbackServerContext* context,
+    const encryption::BatchRequest* request,
+    encryption::BatchResponse* response) {
+    return runOnPool(context, static_cast<size_t>(request->chunks_size()), [this, request, response]() {
+        processBatch(CipherDirection::Decrypt, request, response);
+    });
+}
+
+void EncryptionWorker::encryptChunk(const encryption::ChunkRequest* request,
     encryption::ChunkResponse* response) {
 try {
+    // Work straight off the request's bytes (or its ring slot); nothing is copied into vectors
+    size_t inputSize = request->ring_id() != 0 ? request->input_length() : request->data().size();
+    auto session = requestSession(request, sessions_);
     log("Worker received EncryptChunk request for chunk " + std::to_string(request->chunk_id()) +
-        " (" + std::to_string(request->data().size()) + " bytes)");
-    
-    // Convert protobuf bytes to vectors
-    std::vector<char> data(request->data().begin(), request->data().end());
-    log("Data size: " + std::to_string(data.size()) + " bytes");
-    
-    std::string key(request->key().begin(), request->key().end());
-    log("Key size: " + std::to_string(key.size()) + " bytes");
-    
-    std::string iv(request->iv().begin(), request->iv().end());
-    log("IV size: " + std::to_string(iv.size()) + " bytes");
+        " (" + std::to_string(inputSize) + " bytes" + (request->ring_id() != 0 ? " in shared memory" : "") +
+        (request->session_id() != 0 ? ", session " + std::to_string(request->session_id()) : std::string()) + ")");
 
     // Clear any previous OpenSSL errors
     ERR_clear_error();
 
-    // Encrypt the data
-    log("Starting encryption...");
+    // Encrypt directly into the response buffer
+    CipherMode mode = session->mode;
+    log("Starting encryption (" + AESCrypto::cipherModeName(mode) + ")...");
     auto startTime = std::chrono::high_resolution_clock::now();
-    auto encrypted = AESCrypto::encrypt(data, key, iv);
+    // Reuses this thread's keyed context, so only the IV/nonce is reset per chunk
+    auto ring = requestRing(*request, rings_);
+    size_t encryptedSize = transformChunk(CipherDirection::Encrypt, *request, *session, response, ring.get());
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
     
-    log("Encryption completed (" + std::to_string(encrypted.size()) + " bytes) in " + 
+    log("Encryption completed (" + std::to_string(encryptedSize) + " bytes) in " + 
         std::to_string(duration) + " ms");
 
-    // Set the response
-    log("Setting response...");
-    response->set_processed_data(encrypted.data(), encrypted.size());
-    response->set_chunk_id(request->chunk_id());
     response->set_success(true);
     log("EncryptChunk successful for chunk " + std::to_string(request->chunk_id()));
-    
-    // Verify the response data size matches what was encrypted
-    if (response->processed_data().size() != encrypted.size()) {
-        log("Warning: Response data size (" + std::to_string(response->processed_data().size()) + 
-            ") differs from encrypted data size (" + std::to_string(encrypted.size()) + ")", true);
-    }
 } catch (const std::exception& e) {
     std::string errorMsg = "Encryption error: " + std::string(e.what());
     log(errorMsg, true);
@@ -104,55 +236,38 @@ try {
         response->set_error_message(e.what());
     }
     
+    response->clear_processed_data();
     response->set_success(false);
 }
-
-return grpc::Status::OK;
 }
 
-grpc::Status EncryptionWorker::DecryptChunk(grpc::ServerContext* context, 
-    const encryption::ChunkRequest* request, 
+void EncryptionWorker::decryptChunk(const encryption::ChunkRequest* request,
     encryption::ChunkResponse* response) {
 try {
-    // Convert protobuf bytes to vectors
-    std::vector<unsigned char> encryptedData(request->data().begin(), request->data().end());
-    std::string key(request->key().begin(), request->key().end());
-    std::string iv(request->iv().begin(), request->iv().end());
+    size_t inputSize = request->ring_id() != 0 ? request->input_length() : request->data().size();
+    auto session = requestSession(request, sessions_);
     
     // Print size information for debugging
     log("Decrypting chunk ID: " + std::to_string(request->chunk_id()) + 
-        ", Size: " + std::to_string(encryptedData.size()) + " bytes");
-    
-    // Check if the data is aligned with AES block size (16 bytes)
-    bool isBlockAligned = encryptedData.size() % 16 == 0 && encryptedData.size() > 16;
-    
-    if (isBlockAligned) {
-        log("Using special handling for block-aligned data");
-    }
+        ", Size: " + std::to_string(inputSize) + " bytes" + (request->ring_id() != 0 ? " in shared memory" : ""));
 
     // Clear any previous OpenSSL errors
     ERR_clear_error();
 
-    // Decrypt the data
+    // Decrypt directly into the response buffer
     auto startTime = std::chrono::high_resolution_clock::now();
-    auto decrypted = AESCrypto::decrypt(encryptedData, key, iv);
+    auto ring = requestRing(*request, rings_);
+    size_t decryptedSize = transformChunk(CipherDirection::Decrypt, *request, *session, response, ring.get());
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
     
-    log("Decryption completed (" + std::to_string(decrypted.size()) + " bytes) in " + 
+    log("Decryption completed (" + std::to_string(decryptedSize) + " bytes) in " + 
         std::to_string(duration) + " ms");
 
-    // Set the response
-    response->set_processed_data(decrypted.data(), decrypted.size());
-    response->set_chunk_id(request->chunk_id());
     response->set_success(true);
-    
-    // Verify the response data size matches what was decrypted
-    if (response->processed_data().size() != decrypted.size()) {
-        log("Warning: Response data size (" + std::to_string(response->processed_data().size()) + 
-            ") differs from decrypted data size (" + std::to_string(decrypted.size()) + ")", true);
-    }
 } catch (const std::exception& e) {
+    // Never hand back partial output, e.g. plaintext that failed authentication
+    response->clear_processed_data();
     response->set_success(false);
     
     // Get more detailed OpenSSL error information
@@ -172,17 +287,342 @@ try {
         log("Decryption error: " + std::string(e.what()), true);
     }
 }
+}
+
+void EncryptionWorker::processBatch(CipherDirection direction,
+    const encryption::BatchRequest* request,
+    encryption::BatchResponse* response) {
+    const char* opName = direction == CipherDirection::Encrypt ? "Encrypt" : "Decrypt";
+    auto startTime = std::chrono::high_resolution_clock::now();
+    ERR_clear_error();
+
+    // Entries normally share one session, so it is only looked up again when the id changes
+    std::shared_ptr<const WorkerSession> session;
+    uint64_t sessionId = 0;
+    size_t bytes = 0;
+    size_t failed = 0;
+
+    response->mutable_results()->Reserve(request->chunks_size());
+    for (const auto& entry : request->chunks()) {
+        encryption::ChunkResponse* result = response->add_results();
+        result->set_chunk_id(entry.chunk_id());
+        try {
+            if (!session || entry.session_id() == 0 || entry.session_id() != sessionId) {
+                session = requestSession(&entry, sessions_);
+                sessionId = entry.session_id();
+            }
+            bytes += transformChunk(direction, entry, *session, result);
+            result->set_success(true);
+        } catch (const std::exception& e) {
+            result->clear_processed_data();
+            result->set_success(false);
+            result->set_error_message(e.what());
+            ERR_clear_error();
+            ++failed;
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    log(std::string(opName) + "Batch processed " + std::to_string(request->chunks_size()) + " chunks (" +
+        std::to_string(bytes) + " bytes) in " + std::to_string(duration) + " ms" +
+        (failed > 0 ? ", " + std::to_string(failed) + " failed" : std::string()), failed > 0);
+}
+
+// Positional I/O on a file shared with the master and other workers. Offsets
+// travel in the OVERLAPPED structure, so workers writing different ranges of
+// one file never touch a shared file pointer.
+static HANDLE openShared(const std::string& path, DWORD access) {
+    std::wstring widePath = StringToWString(path);
+    HANDLE file = CreateFileW(widePath.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open " + path + ", error: " + std::to_string(GetLastError()));
+    }
+    return file;
+}
+
+static void readRange(const std::string& path, uint64_t offset, size_t length, std::string& data) {
+    HANDLE file = openShared(path, GENERIC_READ);
+    data.resize(length);
+    size_t done = 0;
+    while (done < length) {
+        uint64_t position = offset + done;
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD toRead = static_cast<DWORD>(std::min<size_t>(length - done, 0x40000000));
+        DWORD bytesRead = 0;
+        if (!ReadFile(file, &data[done], toRead, &bytesRead, &overlapped) || bytesRead == 0) {
+            DWORD error = GetLastError();
+            CloseHandle(file);
+            throw std::runtime_error("Failed to read " + std::to_string(length) + " bytes at offset " +
+                                     std::to_string(offset) + " of " + path + ", error: " + std::to_string(error));
+        }
+        done += bytesRead;
+    }
+    CloseHandle(file);
+}
+
+static void writeRange(const std::string& path, uint64_t offset, const std::string& data) {
+    HANDLE file = openShared(path, GENERIC_WRITE);
+    size_t done = 0;
+    while (done < data.size()) {
+        uint64_t position = offset + done;
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD toWrite = static_cast<DWORD>(std::min<size_t>(data.size() - done, 0x40000000));
+        DWORD bytesWritten = 0;
+        if (!WriteFile(file, data.data() + done, toWrite, &bytesWritten, &overlapped) || bytesWritten == 0) {
+            DWORD error = GetLastError();
+            CloseHandle(file);
+            throw std::runtime_error("Failed to write " + std::to_string(data.size()) + " bytes at offset " +
+                                     std::to_string(offset) + " of " + path + ", error: " + std::to_string(error));
+        }
+        done += bytesWritten;
+    }
+    CloseHandle(file);
+}
+
+void EncryptionWorker::setSharedRoot(const std::string& root) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::canonical(root, ec);
+    if (ec || !std::filesystem::is_directory(canonical, ec)) {
+        throw std::runtime_error("Shared root is not a directory: " + root);
+    }
+    sharedRoot_ = canonical;
+    log("Shared storage root: " + sharedRoot_.string());
+}
+
+// Resolves links and .. components before comparing, so a request cannot
+// reach outside the root through either
+std::string EncryptionWorker::sharedPath(const std::string& path) const {
+    if (sharedRoot_.empty()) {
+        throw std::runtime_error("Shared storage is not enabled on this worker (start it with --shared-root)");
+    }
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    if (ec) {
+        throw std::runtime_error("Invalid shared storage path " + path + ": " + ec.message());
+    }
+    std::filesystem::path relative = canonical.lexically_relative(sharedRoot_);
+    if (relative.empty() || *relative.begin() == "..") {
+        throw std::runtime_error("Path " + path + " is outside the shared root " + sharedRoot_.string());
+    }
+    return canonical.string();
+}
+
+// The input range is read into the request's own data field so the chunk then
+// runs through the same path as EncryptChunk/DecryptChunk. Output is written
+// only once the whole chunk has been processed (and, for GCM, authenticated).
+// A hedged or retried copy of the chunk writes the same bytes to the same range.
+void EncryptionWorker::processRange(const encryption::ChunkRequest* request,
+    encryption::ChunkResponse* response) {
+CipherDirection direction = request->operation() == encryption::OPERATION_DECRYPT
+    ? CipherDirection::Decrypt : CipherDirection::Encrypt;
+try {
+    auto session = requestSession(request, sessions_);
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::string inputPath = sharedPath(request->input_path());
+    std::string outputPath = sharedPath(request->output_path());
+
+    encryption::ChunkRequest chunk;
+    chunk.set_chunk_id(request->chunk_id());
+    readRange(inputPath, request->input_offset(),
+              static_cast<size_t>(request->input_length()), *chunk.mutable_data());
+
+    ERR_clear_error();
+    size_t size = transformChunk(direction, chunk, *session, response);
+    writeRange(outputPath, request->output_offset(), response->processed_data());
+    response->clear_processed_data();
+    response->set_output_length(size);
+    response->set_success(true);
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    log(std::string(direction == CipherDirection::Encrypt ? "Encrypted" : "Decrypted") + " range of chunk " +
+        std::to_string(request->chunk_id()) + " (" + std::to_string(request->input_length()) + " -> " +
+        std::to_string(size) + " bytes at offset " + std::to_string(request->output_offset()) + ") in " +
+        std::to_string(duration) + " ms");
+} catch (const std::exception& e) {
+    response->clear_processed_data();
+    response->set_success(false);
+    response->set_error_message(e.what());
+    ERR_clear_error();
+    log("ProcessRange error for chunk " + std::to_string(request->chunk_id()) + ": " + e.what(), true);
+}
+}
+
+// One ProcessChunks stream. Frames are read one at a time and handed to the
+// crypto pool; results are written back in completion order, one write
+// outstanding at a time. Reading pauses while maxQueued frames are in the
+// pool, so a fast master is held back by HTTP/2 flow control instead of
+// piling frames up in worker memory. gRPC calls are made outside the lock.
+class EncryptionWorker::ChunkStream
+    : public grpc::ServerBidiReactor<encryption::ChunkRequest, encryption::ChunkResponse> {
+public:
+    ChunkStream(EncryptionWorker& worker, size_t maxQueued) : worker_(worker), maxQueued_(maxQueued) {
+        log("Opened chunk stream, up to " + std::to_string(maxQueued) + " frames on the crypto pool");
+        std::unique_lock<std::mutex> lock(mutex_);
+        startRead(lock);
+    }
+
+    void OnReadDone(bool ok) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_ptr<Frame> frame = std::move(reading_);
+        if (!ok) {
+            readDone_ = true;
+            finishIfDone(lock);
+            return;
+        }
+        ++processing_;
+        ++inProcess_;
+        ++worker_.activeChunks_;
+        Frame* task = frame.release();
+        worker_.cryptoPool_->submit([this, task]() { process(std::unique_ptr<Frame>(task)); });
+        if (processing_ < maxQueued_) {
+            startRead(lock);
+        }
+    }
+
+    void OnWriteDone(bool ok) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        writing_.reset();
+        if (!ok) {
+            writeFailed_ = true;
+            written_.clear();  // The master is gone; nothing more can be sent
+        } else {
+            ++processed_;
+        }
+        if (!written_.empty()) {
+            startWrite(lock);
+        } else {
+            finishIfDone(lock);
+        }
+    }
+
+    void OnDone() override {
+        log("Chunk stream closed after " + std::to_string(processed_) + " frames");
+        delete this;
+    }
+
+private:
+    // A frame's request and response share one arena
+    struct Frame {
+        explicit Frame(ArenaStats* stats)
+            : arena(stats),
+              request(arena.create<encryption::ChunkRequest>()),
+              response(arena.create<encryption::ChunkResponse>()) {}
+        CallArena arena;
+        encryption::ChunkRequest* request;
+        encryption::ChunkResponse* response;
+    };
+
+    // Runs on a pool thread
+    void process(std::unique_ptr<Frame> frame) {
+        if (frame->request->operation() == encryption::OPERATION_DECRYPT) {
+            worker_.decryptChunk(frame->request, frame->response);
+        } else {
+            worker_.encryptChunk(frame->request, frame->response);
+        }
+        frame->response->set_request_id(frame->request->request_id());
+        --worker_.activeChunks_;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        --processing_;
+        if (!writeFailed_) {
+            written_.push_back(std::move(frame));
+        }
+        if (!writing_ && !written_.empty()) {
+            startWrite(lock);
+            lock.lock();
+        }
+        if (!reading_ && !readDone_ && processing_ < maxQueued_) {
+            startRead(lock);
+            lock.lock();
+        }
+        // The write started above may complete first; it cannot finish the
+        // stream (and delete it) until this call stops touching it
+        --inProcess_;
+        finishIfDone(lock);
+    }
+
+    // Each of these is called with the lock held and releases it
+    void startRead(std::unique_lock<std::mutex>& lock) {
+        reading_ = std::make_unique<Frame>(&worker_.arenaStats_);
+        encryption::ChunkRequest* request = reading_->request;
+        lock.unlock();
+        StartRead(request);
+    }
+
+    void startWrite(std::unique_lock<std::mutex>& lock) {
+        writing_ = std::move(written_.front());
+        written_.pop_front();
+        const encryption::ChunkResponse* response = writing_->response;
+        lock.unlock();
+        StartWrite(response);
+    }
+
+    void finishIfDone(std::unique_lock<std::mutex>& lock) {
+        if (finished_ || !readDone_ || processing_ > 0 || inProcess_ > 0 || writing_ || !written_.empty()) {
+            lock.unlock();
+            return;
+        }
+        finished_ = true;
+        bool failed = writeFailed_;
+        lock.unlock();
+        Finish(failed ? grpc::Status(grpc::StatusCode::UNAVAILABLE, "Failed to write results to the stream")
+                      : grpc::Status::OK);
+    }
+
+    EncryptionWorker& worker_;
+    size_t maxQueued_;
+    std::mutex mutex_;
+    std::unique_ptr<Frame> reading_;             // Frame the outstanding read fills
+    std::unique_ptr<Frame> writing_;             // Frame the outstanding write sends
+    std::deque<std::unique_ptr<Frame>> written_;  // Processed frames waiting to be written
+    size_t processing_ = 0;
+    size_t inProcess_ = 0;   // process() calls that have not returned
+    size_t processed_ = 0;
+    bool readDone_ = false;
+    bool writeFailed_ = false;
+    bool finished_ = false;
+};
 
-return grpc::Status::OK;
+grpc::ServerBidiReactor<encryption::ChunkRequest, encryption::ChunkResponse>* EncryptionWorker::ProcessChunks(
+    grpc::CallbackServerContext* context) {
+    return new ChunkStream(*this, cryptoPool_->threadCount() * 2);
 }
 
-void EncryptionWorker::runServer(const std::string& serverAddress, bool useTLS) {
+void EncryptionWorker::runServer(const std::string& serverAddress, bool useTLS, const WorkerThreads& threads) {
     // Initialize worker log file if not already open
     if (!workerLogFile.is_open()) {
         workerLogFile.open("worker_debug.log", std::ios::app);
     }
 
     log("Starting worker server at " + serverAddress + (useTLS ? " (with TLS)" : " (insecure)"));
+
+    // Identify the worker by host and port, or by the address it registers under
+    if (!advertiseAddress_.empty()) {
+        workerId_ = advertiseAddress_;
+    } else {
+        char host[256] = {0};
+        DWORD hostSize = sizeof(host);
+        std::string port = serverAddress.substr(serverAddress.rfind(':') + 1);
+        workerId_ = (GetComputerNameA(host, &hostSize) ? std::string(host) : std::string("worker")) + ":" + port;
+    }
+
+    // Every chunk runs on these threads, whatever gRPC does with its own
+    cryptoPool_ = std::make_unique<LocalCryptoPool>(threads.cryptoThreads, true);
+
+    // Measured once here so TestConnection can report it without delay
+    size_t cores = cryptoPool_->threadCount();
+    bytesPerSecond_ = cores * LocalCryptoPool::calibratedThroughput(CipherMode::AES_256_CBC);
+    log("Worker " + workerId_ + ": " + std::to_string(cores) + " pinned crypto threads, " +
+        std::to_string(static_cast<long>(bytesPerSecond_ / (1024 * 1024))) + " MB/s AES-256-CBC" +
+        (AESCrypto::hardwareAes() ? " with AES-NI" : " without AES-NI"));
     
     grpc::ServerBuilder builder;
     
@@ -224,18 +664,168 @@ void EncryptionWorker::runServer(const std::string& serverAddress, bool useTLS)
     std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
     log("Worker server listening on " + serverAddress + 
         (useTLS ? " (with TLS)" : " (insecure)"));
+
+    std::thread heartbeat;
+    if (!masterAddress_.empty()) {
+        server_ = server.get();
+        drainingWorker = this;
+        SetConsoleCtrlHandler(onConsoleCtrl, TRUE);
+        heartbeat = std::thread(&EncryptionWorker::heartbeatLoop, this);
+    }
     server->Wait();
+
+    if (heartbeat.joinable()) {
+        stopHeartbeats();
+        heartbeat.join();
+    }
+
+    std::string arenas = arenaStats_.summary(arenaStats_.arenas);
+    if (!arenas.empty()) {
+        arenas.pop_back();  // Trailing newline
+        log(arenas + " (per RPC or stream frame)");
+    }
+}
+
+// Worker that deregisters from its master on Ctrl+C or when the console closes
+EncryptionWorker* EncryptionWorker::drainingWorker = nullptr;
+
+BOOL WINAPI EncryptionWorker::onConsoleCtrl(DWORD type) {
+    EncryptionWorker* worker = drainingWorker;
+    if (!worker || (type != CTRL_C_EVENT && type != CTRL_BREAK_EVENT && type != CTRL_CLOSE_EVENT)) {
+        return FALSE;
+    }
+    drainingWorker = nullptr;
+    worker->drainAndStop();
+    return TRUE;
+}
+
+void EncryptionWorker::setMaster(const std::string& masterAddress, const std::string& advertiseAddress,
+                                 bool useTLS) {
+    masterAddress_ = masterAddress;
+    advertiseAddress_ = advertiseAddress;
+    masterTLS_ = useTLS;
 }
 
-grpc::Status EncryptionWorker::TestConnection(
-    grpc::ServerContext* context,
+// The registry requires a client certificate under TLS; the worker presents
+// the one it serves with
+std::unique_ptr<encryption::WorkerRegistry::Stub> EncryptionWorker::registryStub() const {
+    if (!masterTLS_) {
+        return encryption::WorkerRegistry::NewStub(
+            grpc::CreateChannel(masterAddress_, grpc::InsecureChannelCredentials()));
+    }
+    grpc::SslCredentialsOptions ssl_opts;
+    ssl_opts.pem_root_certs = ReadFile("ca.crt");
+    ssl_opts.pem_private_key = ReadFile("server.key");
+    ssl_opts.pem_cert_chain = ReadFile("server.crt");
+    return encryption::WorkerRegistry::NewStub(
+        grpc::CreateChannel(masterAddress_, grpc::SslCredentials(ssl_opts)));
+}
+
+void EncryptionWorker::stopHeartbeats() {
+    {
+        std::lock_guard<std::mutex> lock(heartbeatMutex_);
+        stopping_ = true;
+    }
+    heartbeatStopped_.notify_all();
+}
+
+// Registers with the master, then reports load every interval. A master that
+// restarted or dropped this worker answers known = false, so it registers again.
+void EncryptionWorker::heartbeatLoop() {
+    auto stub = registryStub();
+    uint32_t capacity = static_cast<uint32_t>(cryptoPool_->threadCount());
+    std::chrono::milliseconds interval = kDefaultHeartbeatInterval;
+    bool registered = false;
+    bool reachable = true;
+
+    std::unique_lock<std::mutex> lock(heartbeatMutex_);
+    while (!stopping_) {
+        lock.unlock();
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+        grpc::Status status;
+        if (!registered) {
+            encryption::RegisterWorkerRequest request;
+            encryption::RegisterWorkerResponse response;
+            request.set_address(advertiseAddress_);
+            request.set_capacity(capacity);
+            status = stub->RegisterWorker(&context, request, &response);
+            if (status.ok() && response.accepted()) {
+                registered = true;
+                if (response.heartbeat_interval_ms() > 0) {
+                    interval = std::chrono::milliseconds(response.heartbeat_interval_ms());
+                }
+                log("Registered with master " + masterAddress_ + " as " + advertiseAddress_ +
+                    ", heartbeat every " + std::to_string(interval.count()) + " ms");
+            } else if (status.ok()) {
+                log("Master " + masterAddress_ + " rejected registration: " + response.error_message(), true);
+            }
+        } else {
+            encryption::HeartbeatRequest request;
+            encryption::HeartbeatResponse response;
+            request.set_address(advertiseAddress_);
+            request.set_queue_depth(static_cast<uint32_t>(activeChunks_.load()));
+            request.set_capacity(capacity);
+            status = stub->Heartbeat(&context, request, &response);
+            if (status.ok() && !response.known()) {
+                log("Master " + masterAddress_ + " no longer knows this worker, registering again");
+                registered = false;
+            }
+        }
+
+        // Log only changes, not every failed attempt while the master is down
+        if (status.ok() != reachable) {
+            reachable = status.ok();
+            log(reachable ? "Master " + masterAddress_ + " is reachable again"
+                          : "Master " + masterAddress_ + " unreachable: " + status.error_message(), !reachable);
+        }
+
+        lock.lock();
+        if (status.ok() && !registered) {
+            continue;  // Register again straight away
+        }
+        heartbeatStopped_.wait_for(lock, interval, [this] { return stopping_; });
+    }
+}
+
+// The master stops sending new chunks once the worker deregisters; the server
+// then finishes the calls it has before Wait() returns
+void EncryptionWorker::drainAndStop() {
+    log("Draining: deregistering from master " + masterAddress_);
+    stopHeartbeats();
+
+    auto stub = registryStub();
+    grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+    encryption::DeregisterWorkerRequest request;
+    encryption::DeregisterWorkerResponse response;
+    request.set_address(advertiseAddress_);
+    grpc::Status status = stub->DeregisterWorker(&context, request, &response);
+    if (!status.ok()) {
+        log("Failed to deregister from master: " + status.error_message(), true);
+    }
+
+    server_->Shutdown(std::chrono::system_clock::now() + kDrainTimeout);
+    log("Drained, " + std::to_string(activeChunks_.load()) + " chunks still in progress at shutdown");
+}
+
+// The control calls are cheap, so they run on gRPC's thread and finish at once
+grpc::ServerUnaryReactor* EncryptionWorker::TestConnection(grpc::CallbackServerContext* context,
     const encryption::TestRequest* request,
     encryption::TestResponse* response) {
     log("Received test connection request");
     response->set_alive(true);
-    response->set_worker_id("worker_001");
+    response->set_worker_id(workerId_);
     response->set_status("ready");
     response->set_timestamp(time(nullptr));
+    response->set_cores(static_cast<uint32_t>(cryptoPool_->threadCount()));
+    for (CipherMode mode : AESCrypto::availableModes()) {
+        response->add_ciphers(static_cast<encryption::Cipher>(mode));
+    }
+    response->set_aes_ni(AESCrypto::hardwareAes());
+    response->set_host_identity(SharedRing::hostIdentity());
+    response->set_queue_depth(static_cast<uint32_t>(activeChunks_.load()));
+    response->set_bytes_per_second(bytesPerSecond_);
     
     // Add more detailed worker status
     PROCESS_MEMORY_COUNTERS pmc;
@@ -244,5 +834,91 @@ grpc::Status EncryptionWorker::TestConnection(
     }
     
     log("Test connection response sent");
-    return grpc::Status::OK;
-}
\ No newline at end of file
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+    return reactor;
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::OpenSession(grpc::CallbackServerContext* context,
+    const encryption::OpenSessionRequest* request,
+    encryption::OpenSessionResponse* response) {
+try {
+    CipherMode mode = toCipherMode(request->cipher());
+
+    // Check the key material once up front so it fails here, not on every chunk
+    AESCrypto::context(mode, CipherDirection::Encrypt, request->key());
+    if (mode == CipherMode::AES_256_GCM) {
+        AESCrypto::chunkNonce(request->iv(), 0);
+    } else if (request->iv().size() != 16) {
+        throw std::runtime_error("Invalid IV size: Expected 16 bytes");
+    }
+
+    uint64_t id = sessions_.open(mode, request->key(), request->iv());
+    response->set_session_id(id);
+    response->set_success(true);
+    log("Opened session " + std::to_string(id) + " (" + AESCrypto::cipherModeName(mode) + ", " +
+        std::to_string(sessions_.size()) + " open)");
+} catch (const std::exception& e) {
+    response->set_success(false);
+    response->set_error_message(e.what());
+    log("Failed to open session: " + std::string(e.what()), true);
+}
+
+grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+reactor->Finish(grpc::Status::OK);
+return reactor;
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::CloseSession(grpc::CallbackServerContext* context,
+    const encryption::CloseSessionRequest* request,
+    encryption::CloseSessionResponse* response) {
+    bool closed = sessions_.close(request->session_id());
+    response->set_success(closed);
+    if (closed) {
+        log("Closed session " + std::to_string(request->session_id()));
+    } else {
+        log("Close requested for unknown session " + std::to_string(request->session_id()), true);
+    }
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+    return reactor;
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::AttachRing(grpc::CallbackServerContext* context,
+    const encryption::AttachRingRequest* request,
+    encryption::AttachRingResponse* response) {
+grpc::Status status = grpc::Status::OK;
+try {
+    uint64_t id = rings_.attach(request->name(), request->size());
+    response->set_ring_id(id);
+    response->set_success(true);
+    log("Attached shared-memory ring " + request->name() + " (" +
+        std::to_string(request->size() / (1024 * 1024)) + " MB) as ring " + std::to_string(id));
+} catch (const std::invalid_argument& e) {
+    status = grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    log("Rejected ring attach: " + std::string(e.what()), true);
+} catch (const std::exception& e) {
+    response->set_success(false);
+    response->set_error_message(e.what());
+    log("Failed to attach ring: " + std::string(e.what()), true);
+}
+
+grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+reactor->Finish(status);
+return reactor;
+}
+
+grpc::ServerUnaryReactor* EncryptionWorker::DetachRing(grpc::CallbackServerContext* context,
+    const encryption::DetachRingRequest* request,
+    encryption::DetachRingResponse* response) {
+    bool detached = rings_.detach(request->ring_id());
+    response->set_success(detached);
+    if (detached) {
+        log("Detached ring " + std::to_string(request->ring_id()));
+    } else {
+        log("Detach requested for unknown ring " + std::to_string(request->ring_id()), true);
+    }
+    grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+    return reactor;
+}
@@ -0,0 +1,181 @@
+#include "writer.h"
+#include "utilities.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <windows.h>
+
+CompletionBitmap::CompletionBitmap(size_t count) {
+    resize(count);
+}
+
+void CompletionBitmap::resize(size_t count) {
+    count_ = count;
+    completed_ = 0;
+    words_.assign((count + 63) / 64, 0);
+}
+
+bool CompletionBitmap::set(size_t index) {
+    if (index >= count_) {
+        throw std::out_of_range("Chunk index " + std::to_string(index) + " out of range");
+    }
+    uint64_t mask = uint64_t(1) << (index % 64);
+    uint64_t& word = words_[index / 64];
+    if (word & mask) {
+        return false;
+    }
+    word |= mask;
+    ++completed_;
+    return true;
+}
+
+bool CompletionBitmap::test(size_t index) const {
+    if (index >= count_) {
+        return false;
+    }
+    return (words_[index / 64] >> (index % 64)) & 1;
+}
+
+size_t CompletionBitmap::firstMissing() const {
+    for (size_t w = 0; w < words_.size(); ++w) {
+        if (words_[w] != ~uint64_t(0)) {
+            for (size_t bit = 0; bit < 64; ++bit) {
+                size_t index = w * 64 + bit;
+                if (index >= count_) {
+                    return count_;
+                }
+                if (!((words_[w] >> bit) & 1)) {
+                    return index;
+                }
+            }
+        }
+    }
+    return count_;
+}
+
+PositionalFileWriter::PositionalFileWriter(const std::string& path, size_t chunkCount, bool shared)
+    : path_(path), handle_(INVALID_HANDLE_VALUE), completed_(chunkCount) {
+    std::wstring widePath = StringToWString(path);
+    HANDLE hFile = CreateFileW(
+        widePath.c_str(),
+        GENERIC_WRITE,
+        shared ? FILE_SHARE_READ | FILE_SHARE_WRITE : 0,
+        NULL,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if (hFile == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        throw std::runtime_error("Failed to open output file " + path + ", error: " + std::to_string(error));
+    }
+    handle_ = hFile;
+}
+
+PositionalFileWriter::~PositionalFileWriter() {
+    close();
+}
+
+void PositionalFileWriter::writeAt(uint64_t offset, const char* data, size_t size) {
+    HANDLE hFile = static_cast<HANDLE>(handle_);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Output file is closed: " + path_);
+    }
+
+    // The offset travels in the OVERLAPPED structure, so concurrent writers
+    // never depend on (or move) a shared file pointer
+    size_t written = 0;
+    while (written < size) {
+        uint64_t position = offset + written;
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+
+        DWORD toWrite = static_cast<DWORD>(std::min<size_t>(size - written, 0x40000000));
+        DWORD bytesWritten = 0;
+        if (!WriteFile(hFile, data + written, toWrite, &bytesWritten, &overlapped) || bytesWritten == 0) {
+            DWORD error = GetLastError();
+            throw std::runtime_error("Failed to write " + std::to_string(size) + " bytes at offset " +
+                                     std::to_string(offset) + " to " + path_ + ", error: " + std::to_string(error));
+        }
+        written += bytesWritten;
+    }
+}
+
+void PositionalFileWriter::writeChunk(size_t index, uint64_t offset, const std::vector<char>& data) {
+    writeAt(offset, data.data(), data.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completed_.set(index)) {
+        bytesWritten_ += data.size();
+    }
+}
+
+void PositionalFileWriter::recordChunk(size_t index, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completed_.set(index)) {
+        bytesWritten_ += size;
+    }
+}
+
+void PositionalFileWriter::writeChunks(const std::vector<FileChunk>& chunks) {
+    // Lay chunks out by id; only pointers are reordered, never the data
+    std::vector<const FileChunk*> byId(chunks.size(), nullptr);
+    for (const auto& chunk : chunks) {
+        if (chunk.id < 0 || static_cast<size_t>(chunk.id) >= chunks.size() || byId[chunk.id]) {
+            throw std::runtime_error("Chunk ids must be unique and in [0, " + std::to_string(chunks.size()) + ")");
+        }
+        byId[chunk.id] = &chunk;
+    }
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < byId.size(); ++i) {
+        if (byId[i]->data.empty()) {
+            std::cerr << "Warning: Chunk " << i << " is empty, skipping" << std::endl;
+        }
+        writeChunk(i, offset, byId[i]->data);
+        offset += byId[i]->data.size();
+    }
+}
+
+bool PositionalFileWriter::isComplete() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_.all();
+}
+
+size_t PositionalFileWriter::completedChunks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_.completed();
+}
+
+uint64_t PositionalFileWriter::bytesWritten() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytesWritten_;
+}
+
+bool PositionalFileWriter::close() {
+    HANDLE hFile = static_cast<HANDLE>(handle_);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return true;
+    }
+    handle_ = INVALID_HANDLE_VALUE;
+
+    bool success = true;
+    if (!FlushFileBuffers(hFile)) {
+        std::cerr << "Failed to flush " << path_ << ", error: " << GetLastError() << std::endl;
+        success = false;
+    }
+    if (!CloseHandle(hFile)) {
+        std::cerr << "Failed to close " << path_ << ", error: " << GetLastError() << std::endl;
+        success = false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!completed_.all()) {
+        std::cerr << "Warning: " << path_ << " closed with " << completed_.completed() << " of "
+                  << completed_.size() << " chunks written (first missing: " << completed_.firstMissing() << ")" << std::endl;
+        success = false;
+    }
+    return success;
+}